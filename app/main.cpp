@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <exception>
+#include <string_view>
 #include <fmt/core.h>
 #include <magic_enum.hpp>
 #include <spdlog/cfg/env.h>
@@ -6,18 +8,24 @@
 
 #include "configuration.hpp"
 #include "emulator.hpp"
+#include "emulatortuner.hpp"
 #include "gui.hpp"
+#include "launcher.hpp"
 #include "rom/folder.hpp"
 #include "rom/game.hpp"
+#include "schedulingpolicy.hpp"
 #include "softwareinfo.hpp"
 
-int main()
+int main(int argc, char* argv[])
 {
     try
     {
         // Loading log level from environment variable
         spdlog::cfg::load_env_levels();
 
+        // Forked while Enea is still small and single threaded, from now on it spawns every command for us
+        Launcher::start();
+
         spdlog::info("Starting {} {} with render mode {}", projectName, projectVersion,
                      magic_enum::enum_name(Configuration::get().renderMode()));
 
@@ -38,27 +46,48 @@ int main()
             spdlog::warn("Cache folder creation failed at {}", cachePath.string());
         }
 
+        // Pinning Enea before any other thread is started, so every thread inherits it
+        auto policy = SchedulingPolicy::fromFile(Configuration::get().schedulingPolicyFile());
+        spdlog::info("Scheduling policy: {}", policy);
+        policy.pinEnea();
+
+        // Regenerating the emulator configuration if Enea moved to different hardware
+        EmulatorTuner tuner;
+        tuner.tune(Configuration::get().advMameConfigurationFile(), Configuration::get().hardwareFile());
+
         // Searching for roms
         spdlog::info("Searching for roms and media");
         Rom::Folder romFolder(romPath, cachePath);
         romFolder.monitor();
-        std::vector<Rom::Game> romList = romFolder.elements();
+        const bool romsFound = !romFolder.library().load()->empty();
 
-        if (!romFolder.elements().empty())
+        if (romsFound)
         {
             std::ignore = romFolder.writeCache();
         }
 
         // If we found no roms we search for bundled roms as a fallback
-        if (romList.empty())
+        Rom::Folder bundledRomFolder(Configuration::get().bundledRomDirectory(), cachePath);
+        if (!romsFound)
         {
-            Rom::Folder bundledRomFolder(Configuration::get().bundledRomDirectory(), cachePath);
             bundledRomFolder.monitor();
-            romList = bundledRomFolder.elements();
         }
 
-        // Starting gui
-        Gui gui(romList);
+        const auto& library = romsFound ? romFolder.library() : bundledRomFolder.library();
+
+        // In benchmark mode every rom is run once through the emulator, no gui is shown
+        if (argc > 1 && std::string_view(argv[1]) == "--benchmark")
+        {
+            Emulator emulator;
+            auto benchmarks = emulator.benchmark(*library.load(), Configuration::get().benchmarkFile());
+            auto fullSpeed =
+                std::ranges::count_if(benchmarks, [](const auto& entry) { return entry.second.fullSpeed(); });
+            spdlog::info("Benchmark done: {} of {} roms run at full speed", fullSpeed, benchmarks.size());
+            return 0;
+        }
+
+        // Starting gui, it reads the library published by the folder roms were found in
+        Gui gui(library);
         gui.run();
 
         spdlog::info("Stopping {} {}", projectName, projectVersion);
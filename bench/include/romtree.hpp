@@ -0,0 +1,110 @@
+#ifndef ROMTREE_HPP
+#define ROMTREE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "rom/folder.hpp"
+
+namespace Bench {
+
+/**
+ * The shape of a synthetic rom folder. Files are spread evenly over every folder of the tree,
+ * the tree root included.
+ */
+struct TreeShape
+{
+    // Number of rom archives
+    std::size_t roms = 1000;
+    // Number of roms having a screenshot next to them
+    std::size_t screenshots = 1000;
+    // Number of files which are neither roms nor screenshots
+    std::size_t unknownFiles = 0;
+    // Levels of nested folders below the root
+    std::size_t depth = 2;
+    // Number of subfolders in every folder
+    std::size_t fanout = 4;
+};
+
+/**
+ * A synthetic rom folder generated on disk. Roms are named after stems available in the real rom
+ * database so they go through the whole parse pipeline. They are tiny but well formed zip archives
+ * (only the central directory is written) so they also pass the audit.
+ * The whole tree is removed from disk when this object is destroyed.
+ */
+class RomTree
+{
+ private:
+    std::filesystem::path mRoot;
+    std::size_t mFiles = 0;
+
+ public:
+    RomTree() = delete;
+    RomTree(const std::filesystem::path& root, const TreeShape& shape);
+    RomTree(const RomTree& tree) = delete;
+    RomTree(RomTree&& tree) = delete;
+
+    [[nodiscard]] const std::filesystem::path& root() const;
+    [[nodiscard]] std::size_t files() const;
+
+    /**
+     * Every launchable rom name available in the rom database.
+     */
+    [[nodiscard]] static std::vector<std::string> romStems();
+
+    RomTree& operator=(const RomTree& tree) = delete;
+    RomTree& operator=(RomTree&& tree) = delete;
+
+    ~RomTree();
+};
+
+/**
+ * Runs every single phase of a rom source lifecycle on its own, so each of them can be measured.
+ * Phases are private to the source: this class is its friend and forwards to them, nothing else.
+ */
+class Pipeline
+{
+ private:
+    const Rom::Source& mSource;
+
+ public:
+    Pipeline() = delete;
+    explicit inline Pipeline(const Rom::Source& source) : mSource(source) {}
+    Pipeline(const Pipeline& pipeline) = delete;
+    Pipeline(Pipeline&& pipeline) = delete;
+
+    [[nodiscard]] inline std::vector<std::filesystem::path> scan() const
+    {
+        return mSource.scan();
+    }
+
+    [[nodiscard]] inline std::optional<std::string> lastModified() const
+    {
+        return mSource.lastModified();
+    }
+
+    [[nodiscard]] inline std::vector<Rom::Game> parse() const
+    {
+        return mSource.parse();
+    }
+
+    [[nodiscard]] inline std::optional<std::vector<Rom::Game>> cache() const
+    {
+        return mSource.cache();
+    }
+
+    Pipeline& operator=(const Pipeline& pipeline) = delete;
+    Pipeline& operator=(Pipeline&& pipeline) = delete;
+};
+
+/**
+ * Tries to evict the kernel page, dentry and inode caches so the next measurement is a cold one.
+ * This needs root privileges, false is returned when caches could not be dropped.
+ */
+[[nodiscard]] bool dropCaches();
+} // namespace Bench
+
+#endif // ROMTREE_HPP
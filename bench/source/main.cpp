@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+#include <spdlog/spdlog.h>
+
+#include "romtree.hpp"
+#include "utils/filesystem.hpp"
+
+namespace {
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+struct Timing
+{
+    Milliseconds cold;
+    Milliseconds warm;
+    bool trulyCold;
+};
+
+Milliseconds measure(const std::function<void()>& phase)
+{
+    auto start = std::chrono::steady_clock::now();
+    phase();
+    return std::chrono::steady_clock::now() - start;
+}
+
+// Cold is the first run after dropping the kernel caches, warm is the median of the following runs
+Timing coldAndWarm(const std::function<void()>& phase, std::size_t iterations)
+{
+    Timing result{};
+    result.trulyCold = Bench::dropCaches();
+    result.cold = measure(phase);
+
+    std::vector<Milliseconds> warmRuns;
+    for (std::size_t i = 0; i < iterations; i++)
+    {
+        warmRuns.push_back(measure(phase));
+    }
+
+    std::ranges::sort(warmRuns);
+    result.warm = warmRuns.empty() ? result.cold : warmRuns[warmRuns.size() / 2];
+    return result;
+}
+
+void report(const std::string& phase, const Timing& timing)
+{
+    fmt::print("{:<20} {:>12.2f} {:>12.2f}{}\n", phase, timing.cold.count(), timing.warm.count(),
+               timing.trulyCold ? "" : " (caches not dropped)");
+}
+
+std::size_t argument(int argc, char** argv, int index, std::size_t defaultValue)
+{
+    return argc > index ? std::stoul(argv[index]) : defaultValue;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // The pipeline logs every single rom at trace level, we don't want to measure that
+    spdlog::set_level(spdlog::level::warn);
+
+    Bench::TreeShape shape;
+    shape.roms = argument(argc, argv, 1, 10000);
+    shape.screenshots = argument(argc, argv, 2, shape.roms / 2);
+    shape.depth = argument(argc, argv, 3, 3);
+    shape.fanout = argument(argc, argv, 4, 4);
+    shape.unknownFiles = argument(argc, argv, 5, 0);
+    const auto iterations = argument(argc, argv, 6, 5);
+
+    const auto base = std::filesystem::temp_directory_path() / "enea_bench";
+    const auto cacheFolder = base / "cache";
+    std::filesystem::create_directories(cacheFolder);
+
+    fmt::print("Generating rom tree: {} roms, {} screenshots, {} unknown files, depth {}, fanout {}\n", shape.roms,
+               shape.screenshots, shape.unknownFiles, shape.depth, shape.fanout);
+    Bench::RomTree tree(base / "roms", shape);
+    fmt::print("Generated {} files under {}\n\n", tree.files(), tree.root().string());
+
+    fmt::print("{:<20} {:>12} {:>12}\n", "Phase", "Cold (ms)", "Warm (ms)");
+
+#ifdef TARGET_OS_LINUX
+    report("posixFileList", coldAndWarm([&tree]() { std::ignore = utils::filesystem::posixFileList(tree.root()); },
+                                        iterations));
+#endif
+#ifndef USE_POSIX_FILE_LIST
+    report("stdFileList",
+           coldAndWarm([&tree]() { std::ignore = utils::filesystem::stdFileList(tree.root()); }, iterations));
+#endif
+
+    Rom::Folder folder(tree.root(), cacheFolder);
+    Bench::Pipeline pipeline(folder);
+    report("scan", coldAndWarm([&pipeline]() { std::ignore = pipeline.scan(); }, iterations));
+    report("lastModified", coldAndWarm([&pipeline]() { std::ignore = pipeline.lastModified(); }, iterations));
+    report("parse", coldAndWarm([&pipeline]() { std::ignore = pipeline.parse(); }, iterations));
+
+    // Writing and reading the cache need a monitored source
+    folder.monitor();
+    report("writeCache", coldAndWarm([&folder]() { std::ignore = folder.writeCache(); }, iterations));
+    report("cache", coldAndWarm([&pipeline]() { std::ignore = pipeline.cache(); }, iterations));
+
+    std::filesystem::remove_all(base);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,166 @@
+#include "romtree.hpp"
+
+#include <cstdint>
+#include <fstream>
+
+#include <cmrc/cmrc.hpp>
+#include <nlohmann/json.hpp>
+
+#ifdef TARGET_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace {
+// A zip archive containing a single member, we only write what Rom::Archive reads
+std::vector<char> zipArchive(const std::string& member)
+{
+    std::vector<char> result;
+    auto write = [&result](std::uint64_t value, std::size_t bytes) {
+        for (std::size_t i = 0; i < bytes; i++)
+        {
+            result.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    };
+
+    // Central directory header
+    write(0x02014b50, 4);
+    write(20, 2);
+    write(20, 2);
+    write(0, 2);
+    write(0, 2);
+    write(0, 4);
+    write(0, 4);
+    write(0, 4);
+    write(0, 4);
+    write(member.size(), 2);
+    write(0, 2);
+    write(0, 2);
+    write(0, 2);
+    write(0, 2);
+    write(0, 4);
+    write(0, 4);
+    result.insert(result.end(), member.begin(), member.end());
+
+    // End of central directory record
+    const auto directorySize = result.size();
+    write(0x06054b50, 4);
+    write(0, 2);
+    write(0, 2);
+    write(1, 2);
+    write(1, 2);
+    write(directorySize, 4);
+    write(0, 4);
+    write(0, 2);
+
+    return result;
+}
+
+void writeFile(const std::filesystem::path& path, const std::vector<char>& content)
+{
+    std::ofstream file(path, std::ios::binary);
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+}
+} // namespace
+
+Bench::RomTree::RomTree(const std::filesystem::path& root, const TreeShape& shape) : mRoot(root)
+{
+    std::filesystem::remove_all(mRoot);
+    std::filesystem::create_directories(mRoot);
+
+    // Building the folder structure level by level
+    std::vector<std::filesystem::path> folders{mRoot};
+    std::vector<std::filesystem::path> level{mRoot};
+    for (std::size_t depth = 0; depth < shape.depth; depth++)
+    {
+        std::vector<std::filesystem::path> nextLevel;
+        for (const auto& parent : level)
+        {
+            for (std::size_t child = 0; child < shape.fanout; child++)
+            {
+                auto& folder = nextLevel.emplace_back(parent / ("folder" + std::to_string(child)));
+                std::filesystem::create_directory(folder);
+                folders.push_back(folder);
+            }
+        }
+
+        level = std::move(nextLevel);
+    }
+
+    auto stems = romStems();
+    if (stems.empty())
+    {
+        return;
+    }
+
+    const std::vector<char> screenshot{'\x89', 'P', 'N', 'G'};
+    for (std::size_t i = 0; i < shape.roms; i++)
+    {
+        const auto& folder = folders[i % folders.size()];
+        const auto& stem = stems[i % stems.size()];
+        writeFile(folder / (stem + ".zip"), zipArchive(stem + ".bin"));
+        if (i < shape.screenshots)
+        {
+            writeFile(folder / (stem + ".png"), screenshot);
+        }
+    }
+
+    for (std::size_t i = 0; i < shape.unknownFiles; i++)
+    {
+        writeFile(folders[i % folders.size()] / ("readme" + std::to_string(i) + ".txt"), {'e', 'n', 'e', 'a'});
+    }
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(mRoot))
+    {
+        if (entry.is_regular_file())
+        {
+            mFiles++;
+        }
+    }
+}
+
+const std::filesystem::path& Bench::RomTree::root() const
+{
+    return mRoot;
+}
+
+std::size_t Bench::RomTree::files() const
+{
+    return mFiles;
+}
+
+std::vector<std::string> Bench::RomTree::romStems()
+{
+    using RomTable = Database::VTable<std::string, Rom::Definition, Rom::dbPath>;
+    std::vector<std::string> result;
+
+    auto dbFile = cmrc::resources::get_filesystem().open(Rom::dbPath);
+    auto db = nlohmann::json::parse(dbFile.begin(), dbFile.end());
+    for (const auto& value : db.at(RomTable::VALUES_JSON_FIELD))
+    {
+        auto info = value.at(RomTable::VALUE_JSON_FIELD).get<Rom::Info>();
+        if (info.isLaunchable())
+        {
+            result.push_back(value.at(RomTable::KEY_JSON_FIELD).get<std::string>());
+        }
+    }
+
+    return result;
+}
+
+Bench::RomTree::~RomTree()
+{
+    std::error_code ec;
+    std::filesystem::remove_all(mRoot, ec);
+}
+
+bool Bench::dropCaches()
+{
+#ifdef TARGET_OS_LINUX
+    sync();
+    std::ofstream dropCaches("/proc/sys/vm/drop_caches");
+    dropCaches << "3" << std::endl;
+    return dropCaches.good();
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/core.h>
+#include <spdlog/spdlog.h>
+
+#include "launcher.hpp"
+#include "systemcommand.hpp"
+
+#ifdef TARGET_OS_LINUX
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/*
+    Measures how long it takes to launch a trivial command depending on how much memory the launching process has
+    resident, the way Enea does it and with a plain fork (which copies the page tables of the whole process).
+    Launch latency should not depend on the memory footprint of the GUI.
+    Like Enea, commands are spawned by the launcher helper started before any memory is grown. Pass "direct" as third
+    argument to have them spawned by the benchmark process itself instead.
+*/
+namespace {
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+Milliseconds median(const std::function<void()>& launch, std::size_t iterations)
+{
+    std::vector<Milliseconds> runs;
+    for (std::size_t i = 0; i < iterations; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        launch();
+        runs.emplace_back(std::chrono::steady_clock::now() - start);
+    }
+
+    std::ranges::sort(runs);
+    return runs[runs.size() / 2];
+}
+
+void spawn()
+{
+    if (auto process = SystemCommand(std::vector<std::string>{"true"}).spawn(); process.isRight())
+    {
+        std::ignore = process.getRight()->wait();
+    }
+}
+
+#ifdef TARGET_OS_LINUX
+void forkAndExec()
+{
+    if (auto pid = fork(); pid == 0)
+    {
+        execlp("true", "true", nullptr);
+        _exit(127); // NOLINT
+    }
+    else if (pid > 0)
+    {
+        waitpid(pid, nullptr, 0);
+    }
+}
+#endif
+
+std::size_t argument(int argc, char** argv, int index, std::size_t defaultValue)
+{
+    return argc > index ? std::stoul(argv[index]) : defaultValue;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    spdlog::set_level(spdlog::level::warn);
+
+    const auto maxFootprint = argument(argc, argv, 1, 1024);
+    const auto iterations = argument(argc, argv, 2, 50);
+    if (argc <= 3 || std::string_view(argv[3]) != "direct")
+    {
+        Launcher::start();
+    }
+
+    fmt::print("{:<16} {:>12} {:>12}\n", "Footprint (MiB)", "Spawn (ms)", "Fork (ms)");
+
+    // Resident memory is grown step by step, every page is touched so it is really mapped
+    std::vector<std::vector<char>> footprint;
+    for (std::size_t mebibytes = 0; mebibytes <= maxFootprint; mebibytes = std::max<std::size_t>(mebibytes * 4, 64))
+    {
+        while (footprint.size() < mebibytes)
+        {
+            footprint.emplace_back(1024 * 1024, 'e');
+        }
+
+#ifdef TARGET_OS_LINUX
+        fmt::print("{:<16} {:>12.3f} {:>12.3f}\n", mebibytes, median(spawn, iterations).count(),
+                   median(forkAndExec, iterations).count());
+#else
+        fmt::print("{:<16} {:>12.3f} {:>12}\n", mebibytes, median(spawn, iterations).count(), "-");
+#endif
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+#include <fmt/core.h>
+
+#include "internalresourcemanager.hpp"
+#include "textbatch.hpp"
+
+/*
+    Measures what drawing a page of the rom list costs, with one sf::Text per row (how the menu used to draw it) and
+    with a single TextBatch (how it draws it now).
+    Frames are drawn back to back with no vsync and no frame rate limit, so a frame takes what drawing it takes. Run it
+    on the board and driver to be measured, eg: LIBGL_ALWAYS_SOFTWARE=1 for llvmpipe.
+*/
+namespace {
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+// Same as the rom menu
+constexpr unsigned int ROWS = 15;
+constexpr unsigned int CHARACTER_SIZE = 32;
+constexpr float LINE_HEIGHT = 48.0F;
+constexpr unsigned int SCENE_WIDTH = 1920;
+constexpr unsigned int SCENE_HEIGHT = 1080;
+
+const std::vector<std::string> TITLES{"Metal Slug 3", "The King of Fighters '98 - The Slugfest...",
+                                      "Art of Fighting", "Bust-A-Move Again", "Puzzle Bobble 2",
+                                      "Samurai Shodown II", "Street Fighter Alpha 3", "Pulstar",
+                                      "Windjammers", "Blazing Star", "Garou - Mark of the Wolves",
+                                      "Neo Turf Masters", "Last Resort", "Magician Lord", "Twinkle Star Sprites"};
+
+struct Result
+{
+    Milliseconds frame;
+    // sf::Text without outline and sf::VertexArray both issue exactly one OpenGL draw call per target.draw()
+    unsigned int drawCalls;
+};
+
+// A frame is drawn once before measuring, so the glyphs are already in the font texture
+Result measure(sf::RenderWindow& window, std::size_t frames, const std::function<unsigned int()>& draw)
+{
+    Result result{};
+    window.clear();
+    result.drawCalls = draw();
+    window.display();
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < frames; i++)
+    {
+        window.clear();
+        std::ignore = draw();
+        window.display();
+    }
+    result.frame = (std::chrono::steady_clock::now() - start) / static_cast<double>(frames);
+
+    return result;
+}
+
+void report(const std::string& renderer, const Result& result)
+{
+    fmt::print("{:<16} {:>12} {:>12.3f}\n", renderer, result.drawCalls, result.frame.count());
+}
+
+std::size_t argument(int argc, char** argv, int index, std::size_t defaultValue)
+{
+    return argc > index ? std::stoul(argv[index]) : defaultValue;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const auto frames = argument(argc, argv, 1, 2000);
+
+    sf::RenderWindow window(sf::VideoMode::getDesktopMode(), "Enea text benchmark", sf::Style::Fullscreen);
+    window.setVerticalSyncEnabled(false);
+    window.setView(sf::View(sf::FloatRect(0, 0, SCENE_WIDTH, SCENE_HEIGHT)));
+    const auto& font = FontManager::get().getResource("fonts/inter.ttf");
+
+    std::vector<sf::Text> rows;
+    TextBatch batch(font, CHARACTER_SIZE, LINE_HEIGHT);
+    for (unsigned int i = 0; i < ROWS; i++)
+    {
+        const auto color = i == 0 ? sf::Color::White : sf::Color::Red;
+        auto& row = rows.emplace_back(TITLES[i % TITLES.size()], font, CHARACTER_SIZE);
+        row.setFillColor(color);
+        row.setPosition(0, static_cast<float>(i) * LINE_HEIGHT);
+        batch.addLine(TITLES[i % TITLES.size()], color);
+    }
+
+    fmt::print("{} frames of {} rows, {}x{}\n\n", frames, ROWS, window.getSize().x, window.getSize().y);
+    fmt::print("{:<16} {:>12} {:>12}\n", "Renderer", "Draw calls", "Frame (ms)");
+
+    report("sf::Text rows", measure(window, frames, [&window, &rows]() {
+               unsigned int drawCalls = 0;
+               for (const auto& row : rows)
+               {
+                   window.draw(row);
+                   drawCalls++;
+               }
+               return drawCalls;
+           }));
+    report("TextBatch", measure(window, frames, [&window, &batch]() {
+               window.draw(batch);
+               return 1U;
+           }));
+
+    window.close();
+    return EXIT_SUCCESS;
+}
@@ -35,11 +35,18 @@ if(USE_DIRECT_RENDERING)
   endif()
 endif()
 
+# BUILD_BENCHMARKS
+option(
+  BUILD_BENCHMARKS
+  "Build the rom scan pipeline benchmark, which measures every phase against synthetic rom folders"
+  OFF)
+
 # Printing out an option summary
 message(
   "
 -----OPTION SUMMARY-----
 USE_POSIX_FILE_LIST: ${USE_POSIX_FILE_LIST}
 USE_DIRECT_RENDERING: ${USE_DIRECT_RENDERING}
+BUILD_BENCHMARKS: ${BUILD_BENCHMARKS}
 ------------------------
 ")
@@ -9,11 +9,13 @@ class Recipe(ConanFile):
     sfml_options={}
     options = {
         "use_posix_file_list": [True, False],
-        "use_direct_rendering": [True, False]
+        "use_direct_rendering": [True, False],
+        "build_benchmarks": [True, False]
     }
     default_options = {
         "use_posix_file_list": False,
-        "use_direct_rendering": False
+        "use_direct_rendering": False,
+        "build_benchmarks": False
     }
 
     def validate(self):
@@ -32,6 +34,7 @@ class Recipe(ConanFile):
         tc = CMakeToolchain(self)
         tc.variables["USE_POSIX_FILE_LIST"] = self.options.use_posix_file_list
         tc.variables["USE_DIRECT_RENDERING"] = self.options.use_direct_rendering
+        tc.variables["BUILD_BENCHMARKS"] = self.options.build_benchmarks
 
         tc.generate()
 
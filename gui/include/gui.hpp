@@ -1,9 +1,12 @@
 #ifndef GUI_HPP
 #define GUI_HPP
 
+#include <chrono>
 #include <list>
 
 #include "rom/game.hpp"
+#include "rom/library.hpp"
+#include "utils/snapshot.hpp"
 
 class Gui
 {
@@ -11,12 +14,13 @@ class Gui
     static constexpr unsigned int SCENE_WIDTH = 1920;
     static constexpr unsigned int SCENE_HEIGHT = 1080;
     static constexpr unsigned int MAX_FRAME_RATE = 30;
+    static constexpr std::chrono::milliseconds SUSPENDED_POLL_INTERVAL{100};
 
-    std::vector<Rom::Game> mRomList;
+    const Snapshot<Rom::Library>& mLibrary;
 
  public:
     Gui() = delete;
-    explicit Gui(const std::vector<Rom::Game>& romList);
+    explicit Gui(const Snapshot<Rom::Library>& library);
 
     void run();
 };
@@ -0,0 +1,87 @@
+#ifndef IMAGELOADER_HPP
+#define IMAGELOADER_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <SFML/Graphics/Image.hpp>
+
+/**
+ * Reads and decodes images on background threads, so a png or jpeg which is not cached yet never stalls a frame.
+ * Images are only decoded: turning them into textures is left to the thread drawing them.
+ * A new request replaces the one still waiting for a worker, if any: while scrolling only the last rom asked for is
+ * worth decoding. Images already being decoded are finished anyway, they will be cached.
+ */
+class ImageLoader
+{
+ public:
+    static constexpr unsigned int WORKERS = 2;
+
+    struct Image
+    {
+        std::filesystem::path path;
+        // Empty if the file could not be read or decoded
+        std::unique_ptr<sf::Image> image;
+    };
+
+    // Called on the worker threads, returns nothing if the file could not be read or decoded
+    using Decoder = std::function<std::unique_ptr<sf::Image>(const std::filesystem::path& path)>;
+
+ private:
+    const Decoder mDecoder;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::optional<std::filesystem::path> mPending;
+    // Paths being decoded, together with the generation they were requested in
+    std::vector<std::pair<std::filesystem::path, std::uint64_t>> mLoading;
+    std::vector<Image> mLoaded;
+    // Bumped by cancel(), images requested before it are thrown away once decoded
+    std::uint64_t mGeneration = 0;
+    bool mStopping = false;
+    std::vector<std::thread> mWorkers;
+
+    void work();
+
+ public:
+    /**
+     * Workers start right away and use decoder until the loader is destroyed.
+     */
+    explicit ImageLoader(Decoder decoder = &ImageLoader::decode);
+    ImageLoader(const ImageLoader& imageLoader) = delete;
+    ImageLoader(ImageLoader&& imageLoader) = delete;
+
+    /**
+     * Decodes path in background, unless it is already being decoded since the last cancel().
+     */
+    void load(const std::filesystem::path& path);
+
+    /**
+     * Forgets every request, images still being decoded are dropped as soon as they are done.
+     */
+    void cancel();
+
+    /**
+     * Images decoded since the last call. Cheap enough to be called every frame.
+     */
+    [[nodiscard]] std::vector<Image> collect();
+
+    /**
+     * Reads and decodes an image file with SFML, the default decoder.
+     */
+    [[nodiscard]] static std::unique_ptr<sf::Image> decode(const std::filesystem::path& path);
+
+    ImageLoader& operator=(const ImageLoader& imageLoader) = delete;
+    ImageLoader& operator=(ImageLoader&& imageLoader) = delete;
+
+    ~ImageLoader();
+};
+
+#endif // IMAGELOADER_HPP
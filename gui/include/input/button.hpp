@@ -81,7 +81,8 @@ enum class Command
     Up,
     Down,
     Enter,
-    Esc
+    Esc,
+    Sort
 };
 
 struct Axis
@@ -39,6 +39,7 @@ class Manager
     std::vector<Input::Device> mAvailableInputs;
 
     [[nodiscard]] virtual std::list<sf::Event> events(sf::RenderWindow& window) const;
+    void trackDevices(const sf::Event& event);
     void addDevice(const Input::Device& device);
     void removeDevice(const Input::Device& device);
 
@@ -60,6 +61,12 @@ class Manager
     Manager(Manager&& manager) = delete;
 
     void manage(sf::RenderWindow& window);
+
+    /**
+     * Empties the window event queue without reacting to anything, only joystick (dis)connections are tracked.
+     * Meant for when something else (eg: a running game) owns the input.
+     */
+    void drain(sf::RenderWindow& window);
     std::vector<Input::Device> getDevices() const;
 
     Manager& operator=(const Manager& manager) = delete;
@@ -70,6 +77,7 @@ class Manager
     Signal goUp;
     Signal goDown;
     Signal select;
+    Signal changeSort;
     // NOLINTEND
 
     virtual ~Manager() = default;
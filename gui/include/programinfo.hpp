@@ -1,10 +1,14 @@
 #ifndef PROGRAMINFO_HPP
 #define PROGRAMINFO_HPP
 
+#include <future>
+#include <memory>
+#include <optional>
 #include <string_view>
 
 #include <SFML/Graphics/RenderStates.hpp>
 
+#include "emulator.hpp"
 #include "node.hpp"
 
 namespace sf {
@@ -17,11 +21,23 @@ class ProgramInfo : public Node
     static constexpr std::string_view FONT_PATH = "fonts/inter.ttf";
     static constexpr unsigned int FONT_SIZE = 16;
     static constexpr float SPACING = 8.0F;
+    static constexpr std::string_view EMULATOR_CACHE_FILE = "emulator.json";
 
+    Emulator mEmulator;
+    // Declared after the emulator, it may still be probing it in background
+    std::future<std::optional<Emulator::EmulatorInfo>> mEmulatorInfo;
+    std::shared_ptr<TextNode> mBuilderInfo;
+
+    void showEmulatorInfo(const Emulator::EmulatorInfo& info);
     void inline drawEffective(sf::RenderTarget& target, sf::RenderStates states) const override {}
 
  public:
     ProgramInfo();
+
+    /**
+     * Shows the emulator info as soon as it is available. Cheap enough to be called every frame.
+     */
+    void refresh();
 };
 
 #endif // PROGRAMINFO_HPP
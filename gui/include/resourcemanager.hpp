@@ -1,7 +1,9 @@
 #ifndef RESOURCEMANAGER_HPP
 #define RESOURCEMANAGER_HPP
 
+#include <concepts>
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <optional>
 
@@ -28,7 +30,9 @@ template <SFMLLoadable T> class ResourceManager
     };
 
  private:
-    std::map<const std::filesystem::path, const T> mResourceMap;
+    // Not const, resources loaded elsewhere are loaded in place rather than copied in: some, like textures, have no
+    // move constructor and copying them is way more expensive than loading them
+    std::map<const std::filesystem::path, T> mResourceMap;
 
     [[nodiscard]] virtual MemoryRegion loadFromFile(const std::filesystem::path& path) const = 0;
     [[nodiscard]] virtual inline std::optional<T> loadFromMemory(const MemoryRegion& memory) const
@@ -69,6 +73,41 @@ template <SFMLLoadable T> class ResourceManager
         throw ResourceManager::Exception(fmt::format("Cannot load resource {}", path.string()));
     }
 
+    /**
+     * The cached resource, if it was loaded already. Never loads anything, so it never blocks.
+     */
+    [[nodiscard]] inline const T* findResource(const std::filesystem::path& path) const
+    {
+        auto resourceInMap = mResourceMap.find(path);
+        return resourceInMap != mResourceMap.end() ? &resourceInMap->second : nullptr;
+    }
+
+    /**
+     * Caches a resource which is loaded elsewhere, eg: decoded in background and only uploaded here. load is called
+     * with a default constructed resource, in place in the cache, and returns whether it could load it: if not,
+     * nothing is cached and nullptr is returned. A resource already cached is kept and load is not called.
+     */
+    template <std::predicate<T&> F> inline const T* addResource(const std::filesystem::path& path, F&& load)
+    {
+        auto [resource, added] = mResourceMap.try_emplace(path);
+        if (added && !std::invoke(std::forward<F>(load), resource->second))
+        {
+            mResourceMap.erase(resource);
+            return nullptr;
+        }
+
+        return &resource->second;
+    }
+
+    /**
+     * Drops every cached resource, they will be loaded again when needed.
+     * References previously returned by getResource are dangling after this call.
+     */
+    inline void clear()
+    {
+        mResourceMap.clear();
+    }
+
     ResourceManager& operator=(const ResourceManager& resourcemanager) = delete;
     ResourceManager& operator=(ResourceManager&& resourcemanager) = delete;
 
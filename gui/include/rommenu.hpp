@@ -1,10 +1,28 @@
 #ifndef ROMMENU_HPP
 #define ROMMENU_HPP
 
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <magic_enum.hpp>
+
 #include "emulator.hpp"
+#include "imageloader.hpp"
 #include "internalresourcemanager.hpp"
+#include "model.hpp"
+#include "modelview.hpp"
 #include "node.hpp"
 #include "rom/game.hpp"
+#include "rom/library.hpp"
+#include "rom/order.hpp"
+#include "rom/prefetcher.hpp"
+#include "textbatch.hpp"
+#include "utils/snapshot.hpp"
 
 class RomMenu : public Node
 {
@@ -19,24 +37,108 @@ class RomMenu : public Node
     static constexpr float SCREENSHOT_Y_OFFSET = 50.0F;
     static constexpr float SCREENSHOT_WIDTH = 750.0F;
     static constexpr float SCREENSHOT_HEIGHT = 428.0F;
+    static inline const sf::Color PLACEHOLDER_COLOR{40, 40, 40};
+    // How long a rom has to stay selected before its archives are read ahead
+    static constexpr std::chrono::milliseconds PREFETCH_DWELL{300};
+    static constexpr unsigned long NO_PAGE = std::numeric_limits<unsigned long>::max();
+
+    // What is shown for a rom, built the first time the rom is shown and kept until the library changes
+    struct Label
+    {
+        bool ready = false;
+        sf::String row;
+        sf::String name;
+        sf::String info;
+        std::optional<std::filesystem::path> screenshot;
+    };
 
-    std::vector<Rom::Game> mRoms;
+    using View = ModelView<Rom::Library::Index>;
+
+    // Roms are not copied, the model only holds library indexes and every sort order is a live view over it: roms
+    // added by a new library version are placed in every view one by one, nothing is sorted again.
+    // A view is only built when its order is picked for the first time
+    Snapshot<Rom::Library>::Reader mLibrary;
+    // The library version the model and its views were built from
+    std::shared_ptr<const Rom::Library> mShown;
+    Model<Rom::Library::Index> mEntries;
+    std::array<std::optional<View>, magic_enum::enum_count<Rom::Sort>()> mViews;
+    Rom::Sort mSort = Rom::Sort::TITLE;
+    View::Iterator mSelection;
+    // The position of mSelection in the current view
     unsigned long mSelected = 0;
+    bool mSuspended = false;
     const sf::Font& mFont = FontManager::get().getResource("fonts/inter.ttf");
+    Rom::Prefetcher mPrefetcher;
+    std::chrono::steady_clock::time_point mSelectedSince = std::chrono::steady_clock::now();
+    bool mPrefetchPending = true;
+
+    // Indexed by library entry rather than by position, so they survive a sort change
+    std::vector<Label> mLabels;
+    // Built once: moving the selection recolors two rows, only a page change rebuilds the list
+    std::shared_ptr<TextBatch> mList;
+    std::shared_ptr<TextNode> mNameText = std::make_shared<TextNode>();
+    std::shared_ptr<TextNode> mInfoText = std::make_shared<TextNode>();
+    std::shared_ptr<SpriteNode> mScreenshot = std::make_shared<SpriteNode>();
+    std::shared_ptr<RectangleNode> mPlaceholder = std::make_shared<RectangleNode>();
+    ImageLoader mImageLoader;
+    unsigned long mPage = NO_PAGE;
+    unsigned long mHighlighted = 0;
+    float mRowHeight = 0;
+    float mInfoHeight = 0;
 
+    void build();
+    void reorder();
     void reorganize();
-    [[nodiscard]] bool setSelected(unsigned int selected);
-    [[nodiscard]] static std::string romName(const Rom::Game& rom);
-    [[nodiscard]] static std::string shortenedRomName(const Rom::Game& rom);
+    void bindSelected();
+    void bindScreenshot();
+    void uploadScreenshots();
+    [[nodiscard]] Label& label(Rom::Library::Index index);
+    [[nodiscard]] float lineHeight(unsigned int characterSize) const;
+    void selectionChanged();
+    void buildView(Rom::Sort sort);
+    [[nodiscard]] const View& view() const;
+    [[nodiscard]] bool extends(const Rom::Library& library, std::vector<Rom::Library::Index>& relabeled) const;
+    [[nodiscard]] Rom::Library::Index selectedIndex() const;
+    [[nodiscard]] static std::string romName(const Rom::Library::Entry& rom);
+    [[nodiscard]] static std::string shortenedRomName(const Rom::Library::Entry& rom);
     void inline drawEffective(sf::RenderTarget& target, sf::RenderStates states) const override {}
 
  public:
     RomMenu() = delete;
-    explicit RomMenu(const std::vector<Rom::Game>& roms);
+    explicit RomMenu(const Snapshot<Rom::Library>& library);
+
+    /**
+     * Picks up the latest version of the library, if a new one was published, shows the screenshots decoded in
+     * background meanwhile and reads ahead the selected rom once it has been selected for a while. Cheap enough to be
+     * called every frame.
+     */
+    void refresh();
+    [[nodiscard]] bool empty() const;
+
+    /**
+     * Switches to the next sort order. An order is only sorted the first time it is picked, from then on it is kept up
+     * to date as roms come in and switching back to it does not sort anything.
+     */
+    void nextSort();
 
     [[nodiscard]] bool selectionDown();
     [[nodiscard]] bool selectionUp();
-    [[nodiscard]] std::optional<Rom::Game> selectedRom() const;
+
+    /**
+     * The library entry currently selected, it stays valid until the next refresh().
+     */
+    [[nodiscard]] std::optional<Rom::Library::Entry> selectedRom() const;
+
+    /**
+     * Lets go of the screenshot texture, so the screenshot cache can be cleared, nothing is updated again until
+     * resume(). Selection and sort are kept.
+     */
+    void suspend();
+
+    /**
+     * Binds the visible page again.
+     */
+    void resume();
 };
 
 #endif
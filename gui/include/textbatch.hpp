@@ -0,0 +1,76 @@
+#ifndef TEXTBATCH_HPP
+#define TEXTBATCH_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/String.hpp>
+
+#include "node.hpp"
+
+/**
+ * Lines of text laid out one below the other and drawn with a single draw call: every glyph of every line goes in
+ * one vertex array textured with the font glyph page. A stack of sf::Text would cost a draw call and a state change
+ * per line.
+ * Vertices are built when a line is added only, recoloring a line patches its vertices in place.
+ */
+class TextBatch : public Node
+{
+ private:
+    // Where the vertices of a line are in the vertex array
+    struct Line
+    {
+        std::size_t first;
+        std::size_t count;
+        sf::FloatRect bounds;
+    };
+
+    const sf::Font& mFont;
+    unsigned int mCharacterSize;
+    float mLineHeight;
+    sf::VertexArray mVertices{sf::Triangles};
+    std::vector<Line> mLines;
+
+    void addGlyph(const sf::Glyph& glyph, sf::Vector2f position, sf::Color color);
+    void drawEffective(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+ public:
+    TextBatch() = delete;
+    TextBatch(const sf::Font& font, unsigned int characterSize, float lineHeight);
+
+    /**
+     * Drops every line, memory is kept for the next ones.
+     */
+    void clear();
+
+    /**
+     * Adds a line below the last one, laid out as sf::Text would with the same font and character size.
+     */
+    void addLine(const sf::String& string, sf::Color color);
+    void setColor(std::size_t line, sf::Color color);
+
+    [[nodiscard]] inline std::size_t lines() const
+    {
+        return mLines.size();
+    }
+
+    /**
+     * What sf::Text::getLocalBounds() would return for the line, offset by the line position.
+     */
+    [[nodiscard]] inline sf::FloatRect bounds(std::size_t line) const
+    {
+        return mLines.at(line).bounds;
+    }
+
+    // Six per glyph, in order
+    [[nodiscard]] inline const sf::VertexArray& vertices() const
+    {
+        return mVertices;
+    }
+};
+
+#endif // TEXTBATCH_HPP
@@ -1,17 +1,27 @@
 #include "gui.hpp"
 
+#include <chrono>
+#include <future>
+#include <memory>
+#include <optional>
+#include <thread>
+
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Graphics.hpp>
+#include <fmt/format.h>
 #include <magic_enum.hpp>
 #include <spdlog/spdlog.h>
 
+#include "configuration.hpp"
+#include "emulator.hpp"
+#include "externalresourcemanager.hpp"
 #include "input/device.hpp"
 #include "input/manager.hpp"
 #include "programinfo.hpp"
 #include "rommenu.hpp"
 #include "softwareinfo.hpp"
 
-Gui::Gui(const std::vector<Rom::Game>& romList) : mRomList(romList) {}
+Gui::Gui(const Snapshot<Rom::Library>& library) : mLibrary(library) {}
 
 void Gui::run()
 {
@@ -43,7 +53,7 @@ void Gui::run()
     // Drawing rom menu
     const float ROM_MENU_X = view.getSize().x / 9.5F;
     const float ROM_MENU_Y = view.getSize().y / 6.0F;
-    RomMenu romMenu(mRomList);
+    RomMenu romMenu(mLibrary);
     romMenu.setPosition(ROM_MENU_X, ROM_MENU_Y);
 
     // Drawing No Rom Found text
@@ -58,6 +68,22 @@ void Gui::run()
                                    noRomFound.element().getGlobalBounds().height / 2);
     noRomFound.element().setPosition(NO_ROM_FOUND_X, NO_ROM_FOUND_Y);
 
+    // Drawing the text shown while a game is running
+    TextNode launching;
+    launching.element().setFont(FontManager::get().getResource("fonts/inter.ttf"));
+    launching.element().setCharacterSize(32);
+    launching.element().setFillColor(sf::Color::White);
+    launching.element().setPosition(NO_ROM_FOUND_X, NO_ROM_FOUND_Y);
+
+    // The game being played, if any. The loop keeps running while it does so the window stays responsive
+    std::shared_ptr<SystemCommand::Process> game;
+    auto playing = [&game]() { return game != nullptr; };
+
+    // Phases of the last launch, from the select button to the menu being back on screen
+    LaunchTimeline timeline;
+    // The histograms are written in background, the file is parsed and rewritten at every launch
+    std::future<void> recording;
+
     // Creating sounds
     sf::Sound selectionSound;
     selectionSound.setBuffer(SoundManager::get().getResource("audio/move.wav"));
@@ -67,40 +93,145 @@ void Gui::run()
 
     // Connecting signals
     Input::Manager inputmanager;
-    inputmanager.closeWindow.connect([&window]() { window.close(); });
-    inputmanager.goDown.connect([&romMenu, &selectionSound]() {
-        if (romMenu.selectionDown())
+    inputmanager.closeWindow.connect([&window, &playing]() {
+        if (!playing())
+        {
+            window.close();
+        }
+    });
+    inputmanager.goDown.connect([&romMenu, &selectionSound, &playing]() {
+        if (!playing() && romMenu.selectionDown())
         {
             selectionSound.play();
         }
     });
 
-    inputmanager.goUp.connect([&romMenu, &selectionSound]() {
-        if (romMenu.selectionUp())
+    inputmanager.goUp.connect([&romMenu, &selectionSound, &playing]() {
+        if (!playing() && romMenu.selectionUp())
         {
             selectionSound.play();
         }
     });
 
-    inputmanager.select.connect([this, &inputmanager, &romMenu, &launchSound]() {
-        if (!mRomList.empty())
+    inputmanager.changeSort.connect([&romMenu, &selectionSound, &playing]() {
+        if (playing())
+        {
+            return;
+        }
+
+        romMenu.nextSort();
+        selectionSound.play();
+    });
+
+    inputmanager.select.connect([&inputmanager, &romMenu, &launchSound, &launching, &game, &playing, &timeline]() {
+        if (playing())
+        {
+            return;
+        }
+
+        if (auto rom = romMenu.selectedRom(); rom)
         {
+            timeline.reset();
+            timeline.mark(LaunchTimeline::Phase::INPUT_HANDLED);
             launchSound.play();
+            auto controlString = inputmanager.controlString();
+            timeline.mark(LaunchTimeline::Phase::CONTROL_STRING_BUILT);
+
             Emulator emulator;
-            if (auto err = emulator.run(*(romMenu.selectedRom()), inputmanager.controlString()); err)
+            // The only moment a standalone game is built out of the library
+            auto started = emulator.start(rom->game(), controlString, timeline);
+            if (started.isLeft())
             {
-                spdlog::error("Error launching rom: {}", magic_enum::enum_name(*err));
+                spdlog::error("Error launching rom: {}", magic_enum::enum_name(started.getLeft()));
+                return;
             }
+
+            game = started.getRight();
+            launching.element().setString(fmt::format("Playing {}", rom->title()));
+            launching.element().setOrigin(launching.element().getGlobalBounds().width / 2,
+                                          launching.element().getGlobalBounds().height / 2);
         }
     });
 
+    // While a game runs the GUI is suspended: screenshots are released, nothing is drawn and we only wait for the
+    // emulator to exit. Fonts and sounds are tiny and referenced everywhere, they are kept
+    bool suspended = false;
+    auto suspend = [&window, &launching, &romMenu, &suspended]() {
+        // One last frame, so something sensible is on screen if the emulator takes its time to start
+        window.clear();
+        window.draw(launching);
+        window.display();
+
+        romMenu.suspend();
+        ScreenShotManager::get().clear();
+        suspended = true;
+        spdlog::debug("GUI suspended");
+    };
+
+    auto resume = [&romMenu, &suspended]() {
+        romMenu.refresh();
+        romMenu.resume();
+        suspended = false;
+    };
+
     while (window.isOpen())
     {
-        inputmanager.manage(window);
+        if (game)
+        {
+            // While a game runs its buttons are meant for the emulator alone, the frontend must not react to them
+            inputmanager.drain(window);
+
+            if (!suspended)
+            {
+                suspend();
+            }
+
+            auto result = game->poll();
+            if (!result)
+            {
+                std::this_thread::sleep_for(SUSPENDED_POLL_INTERVAL);
+                continue;
+            }
+
+            // Noticed at the first poll after the exit, so this lags behind by up to a poll interval
+            timeline.mark(LaunchTimeline::Phase::CHILD_EXITED);
+
+            if (result->exitCode != 0)
+            {
+                spdlog::error("Emulator exited with exit code: {}", result->exitCode);
+            }
+
+            game.reset();
+            resume();
+        }
+        else
+        {
+            inputmanager.manage(window);
+        }
+
+        romMenu.refresh();
+        programInfo.refresh();
 
         window.clear();
         window.draw(programInfo);
-        mRomList.empty() ? window.draw(noRomFound) : window.draw(romMenu);
+        romMenu.empty() ? window.draw(noRomFound) : window.draw(romMenu);
         window.display();
+
+        // The first frame after a game is over closes the launch, what it took is logged and kept for later
+        if (timeline.duration(LaunchTimeline::Phase::CHILD_EXITED) &&
+            !timeline.duration(LaunchTimeline::Phase::MENU_REDRAWN))
+        {
+            timeline.mark(LaunchTimeline::Phase::MENU_REDRAWN);
+            spdlog::info("Launch phases: {}", timeline.summary());
+
+            // Only whole launches go in the histograms, so every phase is counted the same number of times
+            if (timeline.complete())
+            {
+                recording = std::async(std::launch::async,
+                                       [timeline, histogramFile = Configuration::get().launchHistogramFile()]() {
+                                           std::ignore = timeline.record(histogramFile, projectVersion);
+                                       });
+            }
+        }
     }
 }
@@ -0,0 +1,97 @@
+#include "imageloader.hpp"
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+ImageLoader::ImageLoader(Decoder decoder) : mDecoder(std::move(decoder))
+{
+    for (unsigned int i = 0; i < WORKERS; i++)
+    {
+        mWorkers.emplace_back(&ImageLoader::work, this);
+    }
+}
+
+void ImageLoader::load(const std::filesystem::path& path)
+{
+    std::lock_guard lock(mMutex);
+    // What is being decoded for an earlier generation is thrown away once done, it does not count
+    if (std::ranges::find(mLoading, std::pair(path, mGeneration)) != mLoading.end())
+    {
+        return;
+    }
+
+    mPending = path;
+    mCondition.notify_one();
+}
+
+void ImageLoader::cancel()
+{
+    std::lock_guard lock(mMutex);
+    mPending.reset();
+    mLoaded.clear();
+    mGeneration++;
+}
+
+std::vector<ImageLoader::Image> ImageLoader::collect()
+{
+    std::vector<Image> result;
+
+    std::lock_guard lock(mMutex);
+    std::swap(result, mLoaded);
+    return result;
+}
+
+void ImageLoader::work()
+{
+    std::unique_lock lock(mMutex);
+    while (true)
+    {
+        mCondition.wait(lock, [this]() { return mStopping || mPending; });
+        if (mStopping)
+        {
+            return;
+        }
+
+        auto path = std::move(*mPending);
+        mPending.reset();
+        const std::uint64_t generation = mGeneration;
+        mLoading.emplace_back(path, generation);
+
+        lock.unlock();
+        auto image = mDecoder(path);
+        lock.lock();
+
+        mLoading.erase(std::ranges::find(mLoading, std::pair(path, generation)));
+        if (generation == mGeneration)
+        {
+            mLoaded.push_back(Image{.path = std::move(path), .image = std::move(image)});
+        }
+    }
+}
+
+std::unique_ptr<sf::Image> ImageLoader::decode(const std::filesystem::path& path)
+{
+    auto image = std::make_unique<sf::Image>();
+    if (!image->loadFromFile(path.string()))
+    {
+        spdlog::debug(R"(Image decode operation on "{}". Could not read or decode file)", path.string());
+        return nullptr;
+    }
+
+    return image;
+}
+
+ImageLoader::~ImageLoader()
+{
+    {
+        std::lock_guard lock(mMutex);
+        mStopping = true;
+        mCondition.notify_all();
+    }
+
+    for (auto& worker : mWorkers)
+    {
+        worker.join();
+    }
+}
@@ -74,6 +74,10 @@ const Input::Mapping Input::Device::DEFAULT_KEYBOARD_MAPPING{
         {Frontend::Command::Enter, Input::Frontend::Button{.axis{std::nullopt},
                                                            .joystickButton{std::nullopt},
                                                            .keyboardButton{sf::Keyboard::Key::Num1}}},
+
+        {Frontend::Command::Sort, Input::Frontend::Button{.axis{std::nullopt},
+                                                          .joystickButton{std::nullopt},
+                                                          .keyboardButton{sf::Keyboard::Key::Tab}}},
     }};
 
 const Input::Mapping Input::Device::DEFAULT_JOYSTICK_MAPPING{
@@ -158,12 +162,15 @@ const Input::Mapping Input::Device::DEFAULT_JOYSTICK_MAPPING{
 
         {Frontend::Command::Enter,
          Input::Frontend::Button{.axis{std::nullopt}, .joystickButton{9}, .keyboardButton{std::nullopt}}},
+
+        {Frontend::Command::Sort,
+         Input::Frontend::Button{.axis{std::nullopt}, .joystickButton{8}, .keyboardButton{std::nullopt}}},
     }};
 
 const Input::Mapping Input::Device::DEFAULT_MAPPING{DEFAULT_KEYBOARD_MAPPING};
 
 const std::unordered_map<std::string, unsigned int> Input::Device::DEFAULT_BUTTON_TO_FRONTEND_JOYSTICK_MAPPING{
-    {"start", 9}, {"mode", 10}};
+    {"select", 8}, {"start", 9}, {"mode", 10}};
 
 Input::Device::Device(const Input::Identification& identification, const unsigned int id)
     : mId(id), mIdentification(identification)
@@ -230,7 +237,22 @@ std::optional<Input::Emulator::Button> Input::Device::getEmulatorButton(const Em
 
 std::optional<Input::Frontend::Button> Input::Device::getFrontendButton(const Frontend::Command& command) const
 {
-    return mMapping.getButton(command);
+    if (auto mappingButton = mMapping.getButton(command); mappingButton)
+    {
+        return mappingButton;
+    }
+
+    // Mappings coming from the input database may predate the command, the default of our type is used instead
+    if (mIdentification.type == Type::Keyboard)
+    {
+        return DEFAULT_KEYBOARD_MAPPING.getButton(command);
+    }
+    else if (mIdentification.type == Type::Joystick)
+    {
+        return DEFAULT_JOYSTICK_MAPPING.getButton(command);
+    }
+
+    return std::nullopt;
 }
 
 std::string Input::Device::getEmulatorInputString(const Emulator::Command& command) const
@@ -66,6 +66,14 @@ Input::Manager::Manager()
             return device->checkEvent(Input::Frontend::Command::Enter, event);
         },
         &select);
+
+    // Checking if the user wanted to change the sort order
+    mReactions.emplace_back(
+        [this](const sf::Event& event) {
+            auto device = mAvailableInputs.begin();
+            return device->checkEvent(Input::Frontend::Command::Sort, event);
+        },
+        &changeSort);
 }
 
 std::list<sf::Event> Input::Manager::events(sf::RenderWindow& window) const
@@ -93,33 +101,46 @@ void Input::Manager::manage(sf::RenderWindow& window)
             }
         }
 
-        // Checking if a new joystick has been connected
-        if (event.type == sf::Event::JoystickConnected)
+        trackDevices(event);
+    }
+}
+
+void Input::Manager::drain(sf::RenderWindow& window)
+{
+    for (auto const& event : events(window))
+    {
+        trackDevices(event);
+    }
+}
+
+void Input::Manager::trackDevices(const sf::Event& event)
+{
+    // Checking if a new joystick has been connected
+    if (event.type == sf::Event::JoystickConnected)
+    {
+        auto id = sf::Joystick::getIdentification(event.joystickConnect.joystickId);
+        Input::Identification identification{
+            .type{Input::Type::Joystick}, .name{id.name}, .vendorId{id.vendorId}, .productId{id.productId}};
+        spdlog::info("Querying input database for: {}", identification);
+        auto mapping = Input::Database::get().find(identification);
+        if (mapping.isRight() && mapping.getRight().has_value())
         {
-            auto id = sf::Joystick::getIdentification(event.joystickConnect.joystickId);
-            Input::Identification identification{
-                .type{Input::Type::Joystick}, .name{id.name}, .vendorId{id.vendorId}, .productId{id.productId}};
-            spdlog::info("Querying input database for: {}", identification);
-            auto mapping = Input::Database::get().find(identification);
-            if (mapping.isRight() && mapping.getRight().has_value())
-            {
-                spdlog::info("Found predetermined mapping for: {}", identification);
-                addDevice(Input::Device(identification, event.joystickConnect.joystickId, mapping.getRight().value()));
-            }
-            else
-            {
-                addDevice(Input::Device(identification, event.joystickConnect.joystickId));
-            }
+            spdlog::info("Found predetermined mapping for: {}", identification);
+            addDevice(Input::Device(identification, event.joystickConnect.joystickId, mapping.getRight().value()));
         }
-
-        // Checking if a joystick has been disconnected
-        if (event.type == sf::Event::JoystickDisconnected)
+        else
         {
-            auto id = sf::Joystick::getIdentification(event.joystickConnect.joystickId);
-            removeDevice(Input::Device(Input::Identification{Input::Type::Joystick, id.name, id.vendorId, id.productId},
-                                       event.joystickConnect.joystickId));
+            addDevice(Input::Device(identification, event.joystickConnect.joystickId));
         }
     }
+
+    // Checking if a joystick has been disconnected
+    if (event.type == sf::Event::JoystickDisconnected)
+    {
+        auto id = sf::Joystick::getIdentification(event.joystickConnect.joystickId);
+        removeDevice(Input::Device(Input::Identification{Input::Type::Joystick, id.name, id.vendorId, id.productId},
+                                   event.joystickConnect.joystickId));
+    }
 }
 
 std::vector<Input::Device> Input::Manager::getDevices() const
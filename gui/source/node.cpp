@@ -2,6 +2,11 @@
 
 void Node::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
+    if (!mVisible)
+    {
+        return;
+    }
+
     // Calculating new transformation
     states.transform *= getTransform();
 
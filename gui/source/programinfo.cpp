@@ -1,5 +1,6 @@
 #include "programinfo.hpp"
 
+#include <chrono>
 #include <memory>
 #include <optional>
 
@@ -7,8 +8,9 @@
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/Text.hpp>
 #include <fmt/core.h>
+#include <spdlog/spdlog.h>
 
-#include "emulator.hpp"
+#include "configuration.hpp"
 #include "exception.hpp"
 #include "internalresourcemanager.hpp"
 #include "softwareinfo.hpp"
@@ -22,29 +24,55 @@ ProgramInfo::ProgramInfo()
     softwareInfo->element().setFillColor(sf::Color::Red);
     addChild(softwareInfo);
 
-    auto builderInfo = std::make_shared<TextNode>();
-    builderInfo->element().setFont(FontManager::get().getResource(FONT_PATH));
-    builderInfo->element().setCharacterSize(FONT_SIZE);
-    builderInfo->element().setString(std::string(projectBuilder));
-    builderInfo->element().setFillColor(sf::Color::Red);
-    builderInfo->setPosition(0, softwareInfo->element().getGlobalBounds().height + SPACING);
-    softwareInfo->addChild(builderInfo);
+    mBuilderInfo = std::make_shared<TextNode>();
+    mBuilderInfo->element().setFont(FontManager::get().getResource(FONT_PATH));
+    mBuilderInfo->element().setCharacterSize(FONT_SIZE);
+    mBuilderInfo->element().setString(std::string(projectBuilder));
+    mBuilderInfo->element().setFillColor(sf::Color::Red);
+    mBuilderInfo->setPosition(0, softwareInfo->element().getGlobalBounds().height + SPACING);
+    softwareInfo->addChild(mBuilderInfo);
 
 #ifndef TARGET_OS_WINDOWS
-    Emulator emulator;
-    if (auto info = emulator.info(); info)
+    // The emulator is only launched if it changed since the last time we probed it, otherwise this is ready right away
+    mEmulatorInfo = mEmulator.info(Configuration::get().cacheDirectory() / EMULATOR_CACHE_FILE);
+    if (mEmulatorInfo.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
     {
-        auto emulatorInfo = std::make_shared<TextNode>();
-        emulatorInfo->element().setFont(FontManager::get().getResource(FONT_PATH));
-        emulatorInfo->element().setCharacterSize(FONT_SIZE);
-        emulatorInfo->element().setString(fmt::format("{} {}", info->name, info->version));
-        emulatorInfo->element().setFillColor(sf::Color::Red);
-        emulatorInfo->setPosition(0, builderInfo->element().getGlobalBounds().height + SPACING);
-        builderInfo->addChild(emulatorInfo);
+        if (auto info = mEmulatorInfo.get(); info)
+        {
+            showEmulatorInfo(*info);
+        }
+        else
+        {
+            throw enea::Exception("advanceMAME not found on the system");
+        }
+    }
+#endif
+}
+
+void ProgramInfo::refresh()
+{
+    if (!mEmulatorInfo.valid() || mEmulatorInfo.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        return;
+    }
+
+    if (auto info = mEmulatorInfo.get(); info)
+    {
+        showEmulatorInfo(*info);
     }
     else
     {
-        throw enea::Exception("advanceMAME not found on the system");
+        spdlog::error("advanceMAME could not be probed");
     }
-#endif
+}
+
+void ProgramInfo::showEmulatorInfo(const Emulator::EmulatorInfo& info)
+{
+    auto emulatorInfo = std::make_shared<TextNode>();
+    emulatorInfo->element().setFont(FontManager::get().getResource(FONT_PATH));
+    emulatorInfo->element().setCharacterSize(FONT_SIZE);
+    emulatorInfo->element().setString(fmt::format("{} {}", info.name, info.version));
+    emulatorInfo->element().setFillColor(sf::Color::Red);
+    emulatorInfo->setPosition(0, mBuilderInfo->element().getGlobalBounds().height + SPACING);
+    mBuilderInfo->addChild(emulatorInfo);
 }
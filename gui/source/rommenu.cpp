@@ -2,26 +2,194 @@
 
 #include "externalresourcemanager.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+
 #include <spdlog/spdlog.h>
 
-RomMenu::RomMenu(const std::vector<Rom::Game>& roms)
+RomMenu::RomMenu(const Snapshot<Rom::Library>& library) : mLibrary(library)
+{
+    build();
+    reorder();
+}
+
+void RomMenu::build()
+{
+    mRowHeight = lineHeight(LIST_CHAR_SIZE) + TEXT_SPACING;
+    mInfoHeight = lineHeight(INFO_CHAR_SIZE);
+
+    mList = std::make_shared<TextBatch>(mFont, LIST_CHAR_SIZE, mRowHeight);
+    addChild(mList);
+
+    for (const auto& text : {mNameText, mInfoText})
+    {
+        text->element().setFont(mFont);
+        text->element().setCharacterSize(INFO_CHAR_SIZE);
+        text->element().setFillColor(sf::Color::White);
+        addChild(text);
+    }
+
+    mNameText->setPosition(SCREENSHOT_X_OFFSET, SCREENSHOT_Y_OFFSET);
+    mInfoText->setPosition(SCREENSHOT_X_OFFSET, SCREENSHOT_Y_OFFSET + mInfoHeight + TEXT_SPACING);
+    mScreenshot->setPosition(SCREENSHOT_X_OFFSET,
+                             SCREENSHOT_Y_OFFSET + 2 * mInfoHeight + TEXT_SPACING + SCREENSHOT_SPACING);
+    mScreenshot->setVisible(false);
+    addChild(mScreenshot);
+
+    mPlaceholder->element().setSize({SCREENSHOT_WIDTH, SCREENSHOT_HEIGHT});
+    mPlaceholder->element().setFillColor(PLACEHOLDER_COLOR);
+    // NOLINTNEXTLINE
+    mPlaceholder->setOrigin(SCREENSHOT_WIDTH / 2.0F, 0);
+    mPlaceholder->setPosition(mScreenshot->getPosition());
+    mPlaceholder->setVisible(false);
+    addChild(mPlaceholder);
+}
+
+float RomMenu::lineHeight(const unsigned int characterSize) const
+{
+    // Every line gets the height of one with both an ascender and a descender, whatever it shows: lines never move
+    // and never have to be measured again
+    return sf::Text("Ag", mFont, characterSize).getLocalBounds().height;
+}
+
+void RomMenu::refresh()
+{
+    if (mLibrary.refresh())
+    {
+        reorder();
+    }
+
+    uploadScreenshots();
+
+    if (mPrefetchPending && !mSuspended && !empty() &&
+        std::chrono::steady_clock::now() - mSelectedSince >= PREFETCH_DWELL)
+    {
+        mPrefetcher.prefetch(Rom::Prefetcher::files(*selectedRom()));
+        mPrefetchPending = false;
+    }
+}
+
+void RomMenu::selectionChanged()
+{
+    mPrefetcher.cancel();
+    mSelectedSince = std::chrono::steady_clock::now();
+    mPrefetchPending = true;
+}
+
+bool RomMenu::extends(const Rom::Library& library, std::vector<Rom::Library::Index>& relabeled) const
+{
+    if (!mShown || library.size() < mShown->size())
+    {
+        return !mShown;
+    }
+
+    for (Rom::Library::Index i = 0; i < mShown->size(); i++)
+    {
+        const auto before = (*mShown)[i];
+        const auto after = library[i];
+        if (before.path() != after.path() || before.titleKey() != after.titleKey() || before.year() != after.year() ||
+            before.manufacturerKey() != after.manufacturerKey())
+        {
+            return false;
+        }
+
+        if (before.title() != after.title() || before.manufacturer() != after.manufacturer() ||
+            before.screenshot() != after.screenshot())
+        {
+            relabeled.push_back(i);
+        }
+    }
+
+    return true;
+}
+
+void RomMenu::reorder()
 {
-    for (const auto& rom : roms)
+    static const Rom::Library NO_LIBRARY;
+    const auto& library = mLibrary.get() ? *mLibrary.get() : NO_LIBRARY;
+
+    // A new version usually just adds roms after the ones we already show, those are placed in the views one by one.
+    // Anything else (roms gone, moved or sorted differently) means the library changed altogether: start over
+    std::vector<Rom::Library::Index> relabeled;
+    if (!extends(library, relabeled))
+    {
+        std::ranges::for_each(mViews, [](auto& view) { view.reset(); });
+        mEntries = Model<Rom::Library::Index>();
+        mLabels.clear();
+    }
+
+    // From here on the views compare entries of the new version
+    mShown = mLibrary.get();
+    std::ranges::for_each(relabeled, [this](auto index) { mLabels[index] = Label{}; });
+    mLabels.resize(library.size());
+
+    const auto shown = static_cast<Rom::Library::Index>(mEntries.size());
+    const auto size = static_cast<Rom::Library::Index>(library.size());
+    mEntries.addElements(std::views::iota(shown, size));
+
+    // Views are built after the model is filled: sorting everything once beats placing every rom on its own
+    if (!mViews[magic_enum::enum_integer(mSort)])
     {
-        mRoms.push_back(rom);
+        buildView(mSort);
+        mSelection = view().indexes().begin();
     }
 
-    std::ranges::sort(mRoms, [](const Rom::Game& first, const Rom::Game& second) {
-        std::string firstTitle = first.info().title;
-        std::string secondTitle = second.info().title;
+    // The selected rom stays selected, even if new roms moved it to another page
+    if (mSelection == view().indexes().end())
+    {
+        mSelection = view().indexes().begin();
+    }
 
-        return firstTitle < secondTitle;
-    });
+    mSelected = static_cast<unsigned long>(std::distance(view().indexes().begin(), mSelection));
+    mPage = NO_PAGE;
+    selectionChanged();
+    reorganize();
+}
+
+void RomMenu::buildView(const Rom::Sort sort)
+{
+    mViews[magic_enum::enum_integer(sort)].emplace(
+        mEntries, [this, sort](Rom::Library::Index first, Rom::Library::Index second) {
+            return Rom::precedes(sort, (*mShown)[first], (*mShown)[second]);
+        });
+}
+
+const RomMenu::View& RomMenu::view() const
+{
+    return *mViews[magic_enum::enum_integer(mSort)];
+}
+
+Rom::Library::Index RomMenu::selectedIndex() const
+{
+    return mEntries[*mSelection];
+}
+
+void RomMenu::nextSort()
+{
+    const auto sorts = magic_enum::enum_values<Rom::Sort>();
+    mSort = sorts[(magic_enum::enum_integer(mSort) + 1) % sorts.size()];
+    spdlog::debug("Showing roms sorted by {}", magic_enum::enum_name(mSort));
+
+    // Orders nobody asked for are never sorted, an order is built the first time it is picked and then kept up to date
+    if (!mViews[magic_enum::enum_integer(mSort)])
+    {
+        buildView(mSort);
+    }
 
+    mSelection = view().indexes().begin();
+    mSelected = 0;
+    mPage = NO_PAGE;
+    selectionChanged();
     reorganize();
 }
 
-std::string RomMenu::shortenedRomName(const Rom::Game& rom)
+bool RomMenu::empty() const
+{
+    return mEntries.empty();
+}
+
+std::string RomMenu::shortenedRomName(const Rom::Library::Entry& rom)
 {
     auto result = romName(rom);
     if (result.size() > MAX_CHAR_SIZE_NAME)
@@ -32,126 +200,186 @@ std::string RomMenu::shortenedRomName(const Rom::Game& rom)
     return result;
 }
 
-std::string RomMenu::romName(const Rom::Game& rom)
+std::string RomMenu::romName(const Rom::Library::Entry& rom)
 {
-    std::string result;
+    auto title = rom.title();
+    auto result = title.substr(0, title.find_first_of('('));
+
+    return std::string(result.empty() ? rom.stem() : result);
+}
 
-    result = rom.info().title;
-    result = result.substr(0, result.find_first_of('('));
+void RomMenu::reorganize()
+{
+    // No need to do anything if there is no rom to draw (or if nothing is drawn at all)
+    if (empty() || mSuspended)
+    {
+        return;
+    }
 
-    return result.empty() ? rom.path().stem().string() : result;
+    if (const unsigned long page = mSelected / ROWS; page != mPage)
+    {
+        const auto end = view().indexes().end();
+        auto row = std::prev(mSelection, static_cast<std::ptrdiff_t>(mSelected % ROWS));
+
+        mList->clear();
+        for (unsigned long i = 0; i < ROWS && row != end; i++, row++)
+        {
+            mList->addLine(label(mEntries[*row]).row, sf::Color::Red);
+        }
+
+        mPage = page;
+    }
+    else
+    {
+        mList->setColor(mHighlighted % ROWS, sf::Color::Red);
+    }
+
+    mHighlighted = mSelected;
+    mList->setColor(mHighlighted % ROWS, sf::Color::White);
+    bindSelected();
+}
+
+void RomMenu::bindSelected()
+{
+    auto& selected = label(selectedIndex());
+
+    // Centered above the screenshot, the only texts measured again on every move
+    mNameText->element().setString(selected.name);
+    // NOLINTNEXTLINE
+    mNameText->setOrigin(mNameText->element().getLocalBounds().width / 2.0F, 0);
+    mInfoText->element().setString(selected.info);
+    // NOLINTNEXTLINE
+    mInfoText->setOrigin(mInfoText->element().getLocalBounds().width / 2.0F, 0);
+
+    bindScreenshot();
 }
 
-bool RomMenu::setSelected(const unsigned int selected)
+void RomMenu::bindScreenshot()
 {
-    if (selected < mRoms.size())
+    const auto& selected = label(selectedIndex());
+
+    mScreenshot->setVisible(false);
+    mPlaceholder->setVisible(false);
+    if (!selected.screenshot)
     {
-        mSelected = selected;
-        reorganize();
-        return true;
+        return;
     }
 
-    return false;
+    if (const auto* texture = ScreenShotManager::get().findResource(*selected.screenshot); texture)
+    {
+        const auto size = sf::Vector2f(texture->getSize());
+        mScreenshot->element().setTexture(*texture, true);
+        // NOLINTNEXTLINE
+        mScreenshot->setOrigin(size.x / 2.0F, 0);
+        mScreenshot->setScale(SCREENSHOT_WIDTH / size.x, SCREENSHOT_HEIGHT / size.y);
+        mScreenshot->setVisible(true);
+    }
+    else
+    {
+        // Shown where the screenshot goes until it is decoded, refresh() binds it as soon as it is
+        mPlaceholder->setVisible(true);
+        mImageLoader.load(*selected.screenshot);
+    }
 }
 
-void RomMenu::reorganize()
+void RomMenu::uploadScreenshots()
 {
-    // No need to do anything if there is no rom to draw
-    if (!mRoms.empty())
+    auto images = mImageLoader.collect();
+    if (images.empty())
     {
-        deleteChildren();
-        const unsigned long start = (mSelected / ROWS) * ROWS;
-        // This cast shouldn't be needed but we get compilation errors in armv7hf (?)
-        const unsigned long stop = std::min(static_cast<std::size_t>((mSelected / ROWS) * ROWS + ROWS), mRoms.size());
+        return;
+    }
 
-        std::shared_ptr<TextNode> prev;
+    auto* selected = !empty() ? &label(selectedIndex()) : nullptr;
+    for (const auto& loaded : images)
+    {
+        // Textures can only be created by the thread drawing them, uploading is the only part left to it
+        const bool uploaded =
+            loaded.image && ScreenShotManager::get().addResource(loaded.path, [&loaded](sf::Texture& texture) {
+                return texture.loadFromImage(*loaded.image);
+            });
 
-        for (unsigned long i = start; i < stop; i++)
+        if (!uploaded && selected && selected->screenshot == loaded.path)
         {
-            auto rom = mRoms[i];
-            auto row = std::make_shared<TextNode>();
-            row->element().setString(shortenedRomName(rom));
-            row->element().setFont(mFont);
-            row->element().setCharacterSize(LIST_CHAR_SIZE);
-            i == mSelected ? row->element().setFillColor(sf::Color::White)
-                           : row->element().setFillColor(sf::Color::Red);
-
-            // If it is the first element we just attach it with no offset
-            if (!prev)
-            {
-                addChild(row);
-            }
-            else
-            {
-                row->setPosition(0, prev->element().getGlobalBounds().height + TEXT_SPACING);
-                prev->addChild(row);
-            }
-
-            prev = row;
+            // No screenshot is fine, not looking for it again every time the rom is selected
+            selected->screenshot.reset();
         }
+    }
 
-        // Drawing rom info
-        auto rom = mRoms[mSelected];
-        auto nameText = std::make_shared<TextNode>();
-        nameText->element().setString(romName(rom));
-        nameText->element().setFont(mFont);
-        nameText->element().setCharacterSize(INFO_CHAR_SIZE);
-        nameText->element().setFillColor(sf::Color::White);
-        // NOLINTNEXTLINE
-        nameText->setOrigin(nameText->element().getGlobalBounds().width / 2.0F, 0);
-        nameText->setPosition(SCREENSHOT_X_OFFSET, SCREENSHOT_Y_OFFSET);
-        addChild(nameText);
-
-        auto year = rom.info().year ? *(rom.info().year) : "Unknown Year";
-        auto manufacturer = rom.info().manufacturer ? *(rom.info().manufacturer) : "Unknown Manufacturer";
-        auto infoText = std::make_shared<TextNode>();
-        infoText->element().setString(fmt::format("{}, {}", year, manufacturer));
-        infoText->element().setFont(mFont);
-        infoText->element().setCharacterSize(INFO_CHAR_SIZE);
-        infoText->element().setFillColor(sf::Color::White);
-        // NOLINTNEXTLINE
-        infoText->setOrigin(infoText->element().getGlobalBounds().width / 2.0F, 0);
-        // NOLINTNEXTLINE
-        infoText->setPosition(nameText->element().getGlobalBounds().width / 2.0F,
-                              nameText->element().getGlobalBounds().height + TEXT_SPACING);
-        nameText->addChild(infoText);
+    if (!mSuspended && selected)
+    {
+        bindScreenshot();
+    }
+}
 
-        // Drawing rom screenshot
-        try
-        {
-            if (auto media = rom.media(); media && media->screenshot)
-            {
-                auto screenshotSprite = std::make_shared<SpriteNode>();
-                screenshotSprite->element().setTexture(ScreenShotManager::get().getResource(*(media->screenshot)));
-                auto screenshotWidth = screenshotSprite->element().getGlobalBounds().width;
-                auto screenshotHeight = screenshotSprite->element().getGlobalBounds().height;
-                // NOLINTNEXTLINE
-                screenshotSprite->setOrigin(screenshotWidth / 2.0F, 0);
-                // NOLINTNEXTLINE
-                screenshotSprite->setPosition(infoText->element().getGlobalBounds().width / 2.0F,
-                                              infoText->element().getGlobalBounds().height + SCREENSHOT_SPACING);
-                screenshotSprite->scale(SCREENSHOT_WIDTH / screenshotWidth, SCREENSHOT_HEIGHT / screenshotHeight);
-                infoText->addChild(screenshotSprite);
-            }
-        }
-        catch (const ResourceManager<sf::Texture>::Exception& excep)
-        {
-            // Don't do anything is no screenshot is available, it's fine
-        }
+RomMenu::Label& RomMenu::label(const Rom::Library::Index index)
+{
+    auto& result = mLabels[index];
+    if (!result.ready)
+    {
+        auto rom = (*mShown)[index];
+        result.row = shortenedRomName(rom);
+        result.name = romName(rom);
+        result.info = fmt::format("{}, {}", rom.year().value_or("Unknown Year"),
+                                  rom.manufacturer().value_or("Unknown Manufacturer"));
+        result.screenshot = rom.screenshot();
+        result.ready = true;
     }
+
+    return result;
 }
 
 bool RomMenu::selectionDown()
 {
-    return setSelected(mSelected + 1);
+    if (empty() || std::next(mSelection) == view().indexes().end())
+    {
+        return false;
+    }
+
+    ++mSelection;
+    ++mSelected;
+    selectionChanged();
+    reorganize();
+    return true;
 }
 
 bool RomMenu::selectionUp()
 {
-    return setSelected(mSelected - 1);
+    if (empty() || mSelection == view().indexes().begin())
+    {
+        return false;
+    }
+
+    --mSelection;
+    --mSelected;
+    selectionChanged();
+    reorganize();
+    return true;
+}
+
+std::optional<Rom::Library::Entry> RomMenu::selectedRom() const
+{
+    if (empty())
+    {
+        return std::nullopt;
+    }
+
+    return (*mShown)[selectedIndex()];
+}
+
+void RomMenu::suspend()
+{
+    mSuspended = true;
+    mPage = NO_PAGE;
+    // The cache the texture comes from is cleared while a game runs, nothing decoded meanwhile would be used
+    mImageLoader.cancel();
+    mScreenshot->element() = sf::Sprite();
+    mScreenshot->setVisible(false);
+    mPlaceholder->setVisible(false);
 }
 
-std::optional<Rom::Game> RomMenu::selectedRom() const
+void RomMenu::resume()
 {
-    return mRoms[mSelected];
+    mSuspended = false;
+    reorganize();
 }
@@ -0,0 +1,96 @@
+#include "textbatch.hpp"
+
+#include <algorithm>
+
+#include <SFML/Graphics/RenderTarget.hpp>
+
+TextBatch::TextBatch(const sf::Font& font, const unsigned int characterSize, const float lineHeight)
+    : mFont(font), mCharacterSize(characterSize), mLineHeight(lineHeight)
+{
+}
+
+void TextBatch::clear()
+{
+    mVertices.clear();
+    mLines.clear();
+}
+
+void TextBatch::addLine(const sf::String& string, const sf::Color color)
+{
+    const std::size_t first = mVertices.getVertexCount();
+    const float whitespace = mFont.getGlyph(U' ', mCharacterSize, false).advance;
+
+    // Same origin sf::Text uses: glyphs sit on a baseline one character size below the top of the line
+    sf::Vector2f position(0, static_cast<float>(mLines.size()) * mLineHeight + static_cast<float>(mCharacterSize));
+
+    // Bounds are grown exactly as sf::Text does, starting from its odd initial values
+    sf::Vector2f min(static_cast<float>(mCharacterSize), position.y);
+    sf::Vector2f max(0, 0);
+    sf::Uint32 previous = 0;
+    for (const sf::Uint32 current : string)
+    {
+        position.x += mFont.getKerning(previous, current, mCharacterSize);
+        previous = current;
+
+        if (current == U' ' || current == U'\t')
+        {
+            min = {std::min(min.x, position.x), std::min(min.y, position.y)};
+            position.x += current == U' ' ? whitespace : whitespace * 4;
+            max = {std::max(max.x, position.x), std::max(max.y, position.y)};
+            continue;
+        }
+
+        const auto& glyph = mFont.getGlyph(current, mCharacterSize, false);
+        addGlyph(glyph, position, color);
+        min = {std::min(min.x, position.x + glyph.bounds.left), std::min(min.y, position.y + glyph.bounds.top)};
+        max = {std::max(max.x, position.x + glyph.bounds.left + glyph.bounds.width),
+               std::max(max.y, position.y + glyph.bounds.top + glyph.bounds.height)};
+        position.x += glyph.advance;
+    }
+
+    const auto bounds = string.isEmpty() ? sf::FloatRect() : sf::FloatRect(min, max - min);
+    mLines.push_back(Line{.first = first, .count = mVertices.getVertexCount() - first, .bounds = bounds});
+}
+
+void TextBatch::addGlyph(const sf::Glyph& glyph, const sf::Vector2f position, const sf::Color color)
+{
+    // Glyphs are padded in the font texture, the padding is drawn too so antialiased edges are not cut
+    static constexpr float PADDING = 1.0F;
+
+    const float left = position.x + glyph.bounds.left - PADDING;
+    const float top = position.y + glyph.bounds.top - PADDING;
+    const float right = position.x + glyph.bounds.left + glyph.bounds.width + PADDING;
+    const float bottom = position.y + glyph.bounds.top + glyph.bounds.height + PADDING;
+
+    const auto u1 = static_cast<float>(glyph.textureRect.left) - PADDING;
+    const auto v1 = static_cast<float>(glyph.textureRect.top) - PADDING;
+    const auto u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + PADDING;
+    const auto v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + PADDING;
+
+    mVertices.append(sf::Vertex({left, top}, color, {u1, v1}));
+    mVertices.append(sf::Vertex({right, top}, color, {u2, v1}));
+    mVertices.append(sf::Vertex({left, bottom}, color, {u1, v2}));
+    mVertices.append(sf::Vertex({left, bottom}, color, {u1, v2}));
+    mVertices.append(sf::Vertex({right, top}, color, {u2, v1}));
+    mVertices.append(sf::Vertex({right, bottom}, color, {u2, v2}));
+}
+
+void TextBatch::setColor(const std::size_t line, const sf::Color color)
+{
+    if (line >= mLines.size())
+    {
+        return;
+    }
+
+    for (std::size_t i = mLines[line].first; i < mLines[line].first + mLines[line].count; i++)
+    {
+        mVertices[i].color = color;
+    }
+}
+
+void TextBatch::drawEffective(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    // Texture coordinates are in pixels: they stay valid when the glyph page grows to make room for new glyphs
+    states.texture = &mFont.getTexture(mCharacterSize);
+    target.draw(mVertices, states);
+}
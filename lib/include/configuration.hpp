@@ -36,6 +36,11 @@ class Conf
     [[nodiscard]] std::filesystem::path bundledRomDirectory() const;
     [[nodiscard]] std::filesystem::path cacheDirectory() const;
     [[nodiscard]] std::filesystem::path advMameConfigurationFile() const;
+    [[nodiscard]] std::filesystem::path emulatorLogFile() const;
+    [[nodiscard]] std::filesystem::path schedulingPolicyFile() const;
+    [[nodiscard]] std::filesystem::path benchmarkFile() const;
+    [[nodiscard]] std::filesystem::path hardwareFile() const;
+    [[nodiscard]] std::filesystem::path launchHistogramFile() const;
     [[nodiscard]] inline RenderMode renderMode() const
     {
         return availableRenderMode();
@@ -1,11 +1,23 @@
 #ifndef EMULATOR_HPP
 #define EMULATOR_HPP
 
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
+#include <nlohmann/json.hpp>
+
+#include "launchtimeline.hpp"
 #include "rom/game.hpp"
+#include "rom/library.hpp"
 #include "systemcommand.hpp"
 
 namespace Input::Emulator {
@@ -72,15 +84,42 @@ class Emulator
     {
         std::string name;
         std::string version;
+
+        bool operator==(const EmulatorInfo&) const = default;
     };
 
- private:
-    [[nodiscard]] virtual ChefFun::Either<SystemCommand::Error, SystemCommand::Output>
-    launch(const std::string& arguments) const;
-    [[nodiscard]] virtual bool romExists(const Rom::Game& rom) const;
-    [[nodiscard]] virtual bool romIsReadable(const Rom::Game& rom) const;
+    // What identifies an emulator binary: when any of these changes the binary is probed again
+    struct Fingerprint
+    {
+        std::string path;
+        std::uintmax_t size;
+        std::int64_t lastModified;
+
+        bool operator==(const Fingerprint&) const = default;
+    };
+
+    // How fast a rom runs on this machine with throttling disabled, as a percentage of its original speed
+    struct Benchmark
+    {
+        double speed;
+        // Emulated time the speed was measured on
+        std::uint32_t seconds;
+
+        [[nodiscard]] inline bool fullSpeed() const
+        {
+            return speed >= 100.0;
+        }
+
+        bool operator==(const Benchmark&) const = default;
+    };
+
+    // Benchmark results keyed by rom name (the file stem advmame knows the rom by)
+    using Benchmarks = std::map<std::string, Benchmark>;
+
+    static constexpr std::uint32_t DEFAULT_BENCHMARK_SECONDS = 10;
+    // A benchmark run is cancelled once it took this many times the emulated time
+    static constexpr std::uint32_t BENCHMARK_TIMEOUT_FACTOR = 2;
 
- public:
     enum class Error
     {
         ROM_FILE_NOT_FOUND,
@@ -90,13 +129,87 @@ class Emulator
         NO_VALID_INPUT
     };
 
+ private:
+    static constexpr std::string_view FINGERPRINT_PATH_JSON_FIELD = "path";
+    static constexpr std::string_view FINGERPRINT_SIZE_JSON_FIELD = "size";
+    static constexpr std::string_view FINGERPRINT_LASTMODIFIED_JSON_FIELD = "lastModified";
+    static constexpr std::string_view NAME_JSON_FIELD = "name";
+    static constexpr std::string_view VERSION_JSON_FIELD = "version";
+    static constexpr std::string_view BENCHMARKS_JSON_FIELD = "benchmarks";
+    static constexpr std::string_view SPEED_JSON_FIELD = "speed";
+    static constexpr std::string_view SECONDS_JSON_FIELD = "seconds";
+
+    [[nodiscard]] static Fingerprint fingerprintFromJson(const nlohmann::json& json);
+    static void fingerprintToJson(nlohmann::json& json, const Fingerprint& fingerprint);
+
+    [[nodiscard]] virtual ChefFun::Either<SystemCommand::Error, SystemCommand::Output>
+    launch(const std::vector<std::string>& arguments) const;
+    // Same as above without a window, the emulator is cancelled and an error returned if it runs past timeout
+    [[nodiscard]] virtual ChefFun::Either<SystemCommand::Error, SystemCommand::Output>
+    launchHeadless(const std::vector<std::string>& arguments, std::chrono::milliseconds timeout) const;
+    [[nodiscard]] virtual ChefFun::Either<SystemCommand::Error, std::shared_ptr<SystemCommand::Process>>
+    spawn(const std::vector<std::string>& arguments) const;
+    [[nodiscard]] virtual std::optional<Fingerprint> fingerprint() const;
+    [[nodiscard]] virtual bool romExists(const Rom::Game& rom) const;
+    [[nodiscard]] virtual bool romIsReadable(const Rom::Game& rom) const;
+    [[nodiscard]] std::optional<Error> validate(const Rom::Game& rom) const;
+    [[nodiscard]] ChefFun::Either<Error, std::vector<std::string>> arguments(const Rom::Game& rom,
+                                                                             const std::string& inputString) const;
+    [[nodiscard]] ChefFun::Either<Error, std::vector<std::string>> benchmarkArguments(const Rom::Game& rom,
+                                                                                      std::uint32_t seconds) const;
+
+ public:
     Emulator() = default;
     Emulator(const Emulator& emulator) = delete;
     Emulator(Emulator&& emulator) = delete;
 
     [[nodiscard]] std::optional<EmulatorInfo> info() const;
+
+    /**
+     * Same as info() but the result is kept in cacheFile together with the fingerprint of the binary it comes from.
+     * If the binary did not change since then, the returned future is already satisfied and no process is launched.
+     * Otherwise the emulator is probed in background and the cache rewritten once done.
+     * The future holds nothing if the emulator can't be found or probed. It must not outlive this emulator.
+     */
+    [[nodiscard]] std::future<std::optional<EmulatorInfo>> info(const std::filesystem::path& cacheFile) const;
     [[nodiscard]] std::optional<Error> run(const Rom::Game& rom, const std::string& inputString) const;
 
+    /**
+     * Same checks as Emulator::run but the emulator is left running in background, the caller polls the returned
+     * process to know when the game is over.
+     */
+    [[nodiscard]] ChefFun::Either<Error, std::shared_ptr<SystemCommand::Process>>
+    start(const Rom::Game& rom, const std::string& inputString) const;
+
+    /**
+     * Same as above, the rom validation and the process spawn are marked on timeline.
+     */
+    [[nodiscard]] ChefFun::Either<Error, std::shared_ptr<SystemCommand::Process>>
+    start(const Rom::Game& rom, const std::string& inputString, LaunchTimeline& timeline) const;
+
+    /**
+     * Runs rom for the given amount of emulated time with throttling and sound disabled and measures how fast it went.
+     * The speed advmame reports is used if any, otherwise it is computed from how long the run took (rom loading
+     * included, so it errs on the slow side).
+     * No window is opened: SDL renders every frame in memory, so the cost of presenting frames on screen (vsync, the
+     * display driver) is not part of the measure. A run taking more than BENCHMARK_TIMEOUT_FACTOR times the emulated
+     * time is cancelled and reported as an EMULATOR_ERROR.
+     */
+    [[nodiscard]] ChefFun::Either<Error, Benchmark> benchmark(const Rom::Game& rom,
+                                                              std::uint32_t seconds = DEFAULT_BENCHMARK_SECONDS) const;
+
+    /**
+     * The benchmark results kept in cacheFile. Nothing is returned if they were measured with another emulator binary.
+     */
+    [[nodiscard]] Benchmarks benchmarks(const std::filesystem::path& cacheFile) const;
+
+    /**
+     * Benchmarks every launchable rom of library which has no result in cacheFile yet and returns every result.
+     * The cache is rewritten after each rom, so an interrupted run picks up where it stopped. Roms which fail to run
+     * are reported in the logs and left out.
+     */
+    Benchmarks benchmark(const Rom::Library& library, const std::filesystem::path& cacheFile) const;
+
     Emulator& operator=(const Emulator& emulator) = delete;
     Emulator& operator=(Emulator&& emulator) = delete;
 
@@ -0,0 +1,95 @@
+#ifndef EMULATORTUNER_HPP
+#define EMULATORTUNER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+/**
+ * Writes an advmame configuration tuned for the machine Enea runs on.
+ * The hardware (cores, memory, board model and video modes) is probed and a short calibration measures how fast a
+ * core is and how precise sleeping is. Sync, sound latency, frameskip and resize options are chosen out of that.
+ * The hardware the configuration was generated for is recorded, the configuration is generated again only when it
+ * changes (eg: the sd card moved to another board or another display was plugged in).
+ */
+class EmulatorTuner
+{
+ public:
+    struct VideoMode
+    {
+        unsigned int width;
+        unsigned int height;
+
+        auto operator<=>(const VideoMode&) const = default;
+    };
+
+    // What identifies the machine: when any of these changes the configuration is generated again
+    struct Hardware
+    {
+        unsigned int cores;
+        // Bytes of physical memory, if known
+        std::optional<std::uint64_t> memory;
+        // The board model (eg: "Raspberry Pi 3 Model B Rev 1.2"), only available on device tree based boards
+        std::optional<std::string> model;
+        // Modes of every connected display
+        std::vector<VideoMode> videoModes;
+
+        bool operator==(const Hardware&) const = default;
+    };
+
+    struct Calibration
+    {
+        // Millions of iterations per second of a simple dependent integer loop on a single core
+        double coreSpeed;
+        // Worst overshoot measured when sleeping for a millisecond
+        std::chrono::microseconds timerJitter;
+    };
+
+    // Below this a core is about as fast as a Raspberry Pi 3 one, above FAST_CORE_SPEED as a desktop one
+    static constexpr double SLOW_CORE_SPEED = 400;
+    static constexpr double FAST_CORE_SPEED = 1000;
+
+ private:
+    static constexpr std::string_view CORES_JSON_FIELD = "cores";
+    static constexpr std::string_view MEMORY_JSON_FIELD = "memory";
+    static constexpr std::string_view MODEL_JSON_FIELD = "model";
+    static constexpr std::string_view VIDEOMODES_JSON_FIELD = "videoModes";
+    static constexpr std::string_view WIDTH_JSON_FIELD = "width";
+    static constexpr std::string_view HEIGHT_JSON_FIELD = "height";
+
+    [[nodiscard]] virtual Hardware hardware() const;
+    [[nodiscard]] virtual Calibration calibrate() const;
+
+    [[nodiscard]] static nlohmann::json hardwareToJson(const Hardware& hardware);
+    [[nodiscard]] static Hardware hardwareFromJson(const nlohmann::json& json);
+
+ public:
+    EmulatorTuner() = default;
+    EmulatorTuner(const EmulatorTuner& tuner) = delete;
+    EmulatorTuner(EmulatorTuner&& tuner) = delete;
+
+    /**
+     * The content of an advmame configuration file tuned for the given hardware and calibration.
+     */
+    [[nodiscard]] static std::string configuration(const Hardware& hardware, const Calibration& calibration);
+
+    /**
+     * Generates configurationFile if the hardware changed since the last time it was generated, as recorded in
+     * cacheFile. A configuration file which was not generated by Enea is never touched.
+     * Returns true if the configuration file was written.
+     */
+    bool tune(const std::filesystem::path& configurationFile, const std::filesystem::path& cacheFile) const;
+
+    EmulatorTuner& operator=(const EmulatorTuner& tuner) = delete;
+    EmulatorTuner& operator=(EmulatorTuner&& tuner) = delete;
+
+    virtual ~EmulatorTuner() = default;
+};
+
+#endif // EMULATORTUNER_HPP
@@ -0,0 +1,70 @@
+#ifndef LAUNCHER_HPP
+#define LAUNCHER_HPP
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <ChefFun/Either.hh>
+
+#ifdef TARGET_OS_LINUX
+#include <sys/types.h>
+#endif
+
+/**
+ * A tiny helper process which spawns commands on behalf of Enea.
+ * The helper is forked first thing at startup, while Enea is still small and single threaded, and from then on every
+ * SystemCommand (advmame games as well as its -version and -listxml queries) is spawned by it: the cost of launching
+ * a command never depends on the textures, fonts and mappings the GUI accumulates, and commands are not children of
+ * the GUI process.
+ * Requests go over a unix socket, the helper answers with the pid of the command and hands over two descriptors: one
+ * to read the command output from and one the command wait status is written to once it exits (a command which is not
+ * our child can't be waited on).
+ * If the helper is not running (or it died) SystemCommand spawns commands by itself.
+ */
+class Launcher
+{
+ public:
+#ifdef TARGET_OS_LINUX
+    // A command spawned by the helper, descriptors belong to the caller
+    struct Child
+    {
+        pid_t pid;
+        int outputFd;
+        int statusFd;
+    };
+#endif
+
+ private:
+    // Held for a whole request, so answers never get mixed up between threads
+    static inline std::mutex mMutex;
+    static inline int mSocket = -1;
+
+ public:
+    Launcher() = delete;
+    Launcher(const Launcher&) = delete;
+    Launcher(Launcher&&) = delete;
+
+    /**
+     * Forks the helper, it lives until Enea exits. Returns false if the helper could not be started.
+     * Only supported on Linux, anywhere else it does nothing.
+     */
+    static bool start();
+
+    [[nodiscard]] static bool running();
+
+#ifdef TARGET_OS_LINUX
+    /**
+     * Has the helper spawn a command with exactly the given environment ("NAME=value" strings). The command gets its
+     * own process group, its output goes to Child::outputFd.
+     * Returns the errno describing the failure otherwise.
+     */
+    [[nodiscard]] static ChefFun::Either<int, Child> spawn(const std::vector<std::string>& arguments,
+                                                          const std::vector<std::string>& environment);
+#endif
+
+    Launcher& operator=(const Launcher&) = delete;
+    Launcher& operator=(Launcher&&) = delete;
+};
+
+#endif // LAUNCHER_HPP
@@ -0,0 +1,69 @@
+#ifndef LAUNCHTIMELINE_HPP
+#define LAUNCHTIMELINE_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <magic_enum.hpp>
+
+/**
+ * Timestamps of the phases a game launch goes through, from the select button being handled to the menu being
+ * back on screen once the game is over.
+ * Once a launch is complete its phases can be added to a histogram file, which keeps how long every phase took over
+ * every launch, one histogram per Enea version so regressions stand out when comparing releases.
+ */
+class LaunchTimeline
+{
+ public:
+    using Clock = std::chrono::steady_clock;
+
+    // In the order they happen
+    enum class Phase
+    {
+        INPUT_HANDLED,
+        CONTROL_STRING_BUILT,
+        ROM_VALIDATED,
+        PROCESS_SPAWNED,
+        CHILD_EXITED,
+        MENU_REDRAWN
+    };
+
+    static constexpr std::string_view COUNT_JSON_FIELD = "count";
+    static constexpr std::string_view TOTAL_JSON_FIELD = "totalMicroseconds";
+    static constexpr std::string_view BUCKETS_JSON_FIELD = "buckets";
+
+    // Bucket n counts the phases which took less than 2^n microseconds (and at least 2^(n-1)), the last one is open
+    static constexpr std::size_t BUCKETS = 32;
+
+ private:
+    std::array<std::optional<Clock::time_point>, magic_enum::enum_count<Phase>()> mMarks;
+
+ public:
+    void mark(Phase phase, Clock::time_point when = Clock::now());
+    void reset();
+
+    /**
+     * How long a phase took, that is the time since the phase before it. Nothing if either was not marked.
+     * The first phase always takes no time.
+     */
+    [[nodiscard]] std::optional<Clock::duration> duration(Phase phase) const;
+    [[nodiscard]] bool complete() const;
+
+    /**
+     * One line with how long every marked phase took, eg: "INPUT_HANDLED +0.00ms, CONTROL_STRING_BUILT +0.12ms, ..."
+     */
+    [[nodiscard]] std::string summary() const;
+
+    /**
+     * Adds every marked phase to the histograms kept in histogramFile for the given version. A missing or malformed
+     * file is started over. Returns false if the file could not be written.
+     */
+    bool record(const std::filesystem::path& histogramFile, std::string_view version) const;
+};
+
+#endif // LAUNCHTIMELINE_HPP
@@ -1,6 +1,14 @@
 #ifndef MODEL_HPP
 #define MODEL_HPP
 
+#include <optional>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
 #include <rocket.hpp>
 #include <uuid.h>
 
@@ -10,23 +18,27 @@ template <typename T> class ModelElement
     uuids::uuid mUuid;
     T mElement;
 
- public:
-    rocket::signal<void()> modified;
+    [[nodiscard]] static inline uuids::uuid newUuid()
+    {
+        // Seeding a mersenne twister is way more expensive than generating a uuid, so we do it once per thread
+        thread_local std::mt19937 generator = []() {
+            std::random_device rd;
+            auto seed_data = std::array<int, std::mt19937::state_size>{};
+            std::ranges::generate(seed_data, std::ref(rd));
+            std::seed_seq seq(std::begin(seed_data), std::end(seed_data));
+            return std::mt19937(seq);
+        }();
+        thread_local uuids::uuid_random_generator gen{generator};
+
+        return gen();
+    }
 
+ public:
     ModelElement() = delete;
     ModelElement(const ModelElement&) = delete;
     ModelElement(ModelElement&&) noexcept = default;
-    inline explicit ModelElement(const T& element) : mElement(element)
-    {
-        std::random_device rd;
-        auto seed_data = std::array<int, std::mt19937::state_size>{};
-        std::ranges::generate(seed_data, std::ref(rd));
-        std::seed_seq seq(std::begin(seed_data), std::end(seed_data));
-        std::mt19937 generator(seq);
-        uuids::uuid_random_generator gen{generator};
-
-        mUuid = gen();
-    }
+    inline explicit ModelElement(const T& element) : mUuid(newUuid()), mElement(element) {}
+    inline explicit ModelElement(T&& element) : mUuid(newUuid()), mElement(std::move(element)) {}
 
     [[nodiscard]] inline uuids::uuid uuid() const
     {
@@ -36,7 +48,6 @@ template <typename T> class ModelElement
     inline void reset(const T& element)
     {
         mElement = element;
-        modified();
     }
 
     [[nodiscard]] inline const T* operator->() const
@@ -57,24 +68,132 @@ template <typename T> class ModelElement
 template <typename T> class Model
 {
  private:
+    using ElementSignal = rocket::signal<void(const uuids::uuid& uuid, const T& element)>;
+    using ElementsSignal = rocket::signal<void(std::span<const ModelElement<T>> elements)>;
+
     std::vector<ModelElement<T>> mElements;
-    rocket::scoped_connection_container mElementConnections;
+    // Where every element sits in mElements, elements never move to another position
+    std::unordered_map<uuids::uuid, std::size_t> mIndexes;
+
+    ElementSignal mElementAdded;
+    ElementSignal mElementModified;
+    ElementsSignal mElementsAdded;
 
-    rocket::signal<void(const uuids::uuid& uuid, const T& element)> elementAdded;
-    rocket::signal<void(const uuids::uuid& uuid, const T& element)> elementModified;
+    template <typename U> inline const ModelElement<T>& emplace(U&& element)
+    {
+        const auto& elem = mElements.emplace_back(std::forward<U>(element));
+        mIndexes.emplace(elem.uuid(), mElements.size() - 1);
+        return elem;
+    }
 
  public:
     Model(const Model&) = delete;
     Model() = default;
     Model(Model&&) noexcept = default;
 
+    /**
+     * Connect a slot to the model notifications, the returned connection can be used to disconnect it.
+     * Only the model emits them: addElement() notifies every element it adds, addElements() notifies once per call with
+     * every element it added and modifyElement() notifies the element it modified.
+     */
+    template <typename F> inline rocket::connection onElementAdded(F&& slot)
+    {
+        return mElementAdded.connect(std::forward<F>(slot));
+    }
+
+    template <typename F> inline rocket::connection onElementsAdded(F&& slot)
+    {
+        return mElementsAdded.connect(std::forward<F>(slot));
+    }
+
+    template <typename F> inline rocket::connection onElementModified(F&& slot)
+    {
+        return mElementModified.connect(std::forward<F>(slot));
+    }
+
     inline void addElement(const T& element)
     {
-        auto& elem = mElements.emplace_back(element);
-        mElementConnections += {elem.modified.connect([&elem, this]() { elementModified(elem.uuid(), *elem); })};
-        elementAdded(elem.uuid(), *elem);
+        const auto& elem = emplace(element);
+        mElementAdded(elem.uuid(), *elem);
     }
 
+    inline void addElement(T&& element)
+    {
+        const auto& elem = emplace(std::move(element));
+        mElementAdded(elem.uuid(), *elem);
+    }
+
+    /**
+     * Adds every element of a range in one go, elements are moved in when the range is an rvalue.
+     * Per element elementAdded signals are not emitted, subscribers are notified once through elementsAdded.
+     */
+    template <std::ranges::input_range R> inline void addElements(R&& elements)
+    {
+        const auto first = mElements.size();
+        if constexpr (std::ranges::sized_range<R>)
+        {
+            mElements.reserve(first + std::ranges::size(elements));
+            mIndexes.reserve(first + std::ranges::size(elements));
+        }
+
+        for (auto&& element : elements)
+        {
+            if constexpr (std::is_lvalue_reference_v<R>)
+            {
+                std::ignore = emplace(element);
+            }
+            else
+            {
+                std::ignore = emplace(std::move(element));
+            }
+        }
+
+        if (mElements.size() > first)
+        {
+            mElementsAdded(std::span<const ModelElement<T>>(mElements).subspan(first));
+        }
+    }
+
+    /**
+     * Replaces the element identified by the given uuid and emits elementModified.
+     * Returns false if no such element exists.
+     */
+    inline bool modifyElement(const uuids::uuid& uuid, const T& element)
+    {
+        auto found = mIndexes.find(uuid);
+        if (found == mIndexes.end())
+        {
+            return false;
+        }
+
+        auto& elem = mElements[found->second];
+        elem.reset(element);
+        mElementModified(elem.uuid(), *elem);
+        return true;
+    }
+
+    /**
+     * Returns the position of the element identified by the given uuid. Elements never move, so the position of an
+     * element does not change for the whole model lifetime.
+     */
+    [[nodiscard]] inline std::optional<std::size_t> index(const uuids::uuid& uuid) const
+    {
+        if (auto found = mIndexes.find(uuid); found != mIndexes.end())
+        {
+            return found->second;
+        }
+
+        return std::nullopt;
+    }
+
+    [[nodiscard]] inline const T& operator[](std::size_t index) const
+    {
+        return *mElements[index];
+    }
+
+    /**
+     * Returns a copy of every element in the model. Prefer view() when a copy is not really needed.
+     */
     [[nodiscard]] inline std::vector<T> elements() const
     {
         std::vector<T> result;
@@ -86,6 +205,26 @@ template <typename T> class Model
         return result;
     }
 
+    /**
+     * Returns a read only view over the model elements, nothing is copied.
+     * Just like std::vector iterators the view, its iterators and every reference obtained through it are
+     * invalidated as soon as a new element is added to the model (or the model is moved or destroyed).
+     */
+    [[nodiscard]] inline auto view() const
+    {
+        return mElements | std::views::transform([](const ModelElement<T>& element) -> const T& { return *element; });
+    }
+
+    [[nodiscard]] inline std::size_t size() const
+    {
+        return mElements.size();
+    }
+
+    [[nodiscard]] inline bool empty() const
+    {
+        return mElements.empty();
+    }
+
     inline bool operator==(const Model&) const = delete;
     Model& operator=(const Model&) = delete;
     Model& operator=(Model&&) noexcept = default;
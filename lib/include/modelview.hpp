@@ -0,0 +1,178 @@
+#ifndef MODELVIEW_HPP
+#define MODELVIEW_HPP
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <ranges>
+#include <set>
+#include <vector>
+
+#include "model.hpp"
+
+/**
+ * A live, filtered and sorted view over a Model.
+ * The view subscribes to the model notifications and keeps itself up to date: every added or modified element is
+ * placed in (or removed from) the view in O(log n), the whole model is never scanned or sorted again.
+ * Elements which compare equivalent keep the order in which they were added to the model.
+ *
+ * The view holds a reference to its model so it must not outlive it, nor can the model be moved while it has views.
+ * Iterators of the view are invalidated only when the element they point to is modified, but references to the
+ * elements themselves follow the rules of Model::view().
+ */
+template <typename T> class ModelView
+{
+ public:
+    using Filter = std::function<bool(const T& element)>;
+    using Compare = std::function<bool(const T& first, const T& second)>;
+    // Model positions of the elements of the view, in order
+    using Indexes = std::set<std::size_t, std::function<bool(std::size_t first, std::size_t second)>>;
+    using Iterator = typename Indexes::const_iterator;
+
+ private:
+    const Model<T>& mModel;
+    Filter mFilter;
+    Compare mCompare;
+    Indexes mIndexes;
+    // Where every model element sits in mIndexes, if it passed the filter
+    std::vector<std::optional<Iterator>> mPositions;
+    rocket::scoped_connection_container mConnections;
+
+    [[nodiscard]] inline bool less(std::size_t first, std::size_t second) const
+    {
+        const auto& firstElement = mModel[first];
+        const auto& secondElement = mModel[second];
+
+        if (mCompare(firstElement, secondElement))
+        {
+            return true;
+        }
+
+        if (mCompare(secondElement, firstElement))
+        {
+            return false;
+        }
+
+        return first < second;
+    }
+
+    [[nodiscard]] inline bool accepts(std::size_t index) const
+    {
+        return !mFilter || mFilter(mModel[index]);
+    }
+
+    inline void insert(std::size_t index)
+    {
+        if (index >= mPositions.size())
+        {
+            mPositions.resize(index + 1);
+        }
+
+        if (accepts(index))
+        {
+            mPositions[index] = mIndexes.insert(index).first;
+        }
+    }
+
+    inline void update(std::size_t index)
+    {
+        // The element already changed so the set can't search for it, but erasing through an iterator needs no
+        // comparison at all
+        if (index < mPositions.size() && mPositions[index])
+        {
+            mIndexes.erase(*mPositions[index]);
+            mPositions[index].reset();
+        }
+
+        insert(index);
+    }
+
+ public:
+    ModelView() = delete;
+    ModelView(const ModelView&) = delete;
+    ModelView(ModelView&&) = delete;
+
+    /**
+     * Builds a view over the given model, ordered by compare. An empty filter lets every element in.
+     * Elements already in the model are sorted once, which is way cheaper than placing them one by one.
+     */
+    inline ModelView(Model<T>& model, Compare compare, Filter filter = {})
+        : mModel(model), mFilter(std::move(filter)), mCompare(std::move(compare)),
+          mIndexes([this](std::size_t first, std::size_t second) { return less(first, second); })
+    {
+        std::vector<std::size_t> sorted;
+        sorted.reserve(mModel.size());
+        for (std::size_t i = 0; i < mModel.size(); i++)
+        {
+            if (accepts(i))
+            {
+                sorted.push_back(i);
+            }
+        }
+
+        std::ranges::sort(sorted, [this](std::size_t first, std::size_t second) { return less(first, second); });
+
+        // Every element goes right at the end of the set, so the hint makes each insertion constant time
+        mPositions.resize(mModel.size());
+        for (auto index : sorted)
+        {
+            mPositions[index] = mIndexes.insert(mIndexes.end(), index);
+        }
+
+        mConnections += {model.onElementAdded([this](const uuids::uuid& uuid, const T&) {
+            if (auto index = mModel.index(uuid); index)
+            {
+                insert(*index);
+            }
+        })};
+
+        mConnections += {model.onElementsAdded([this](std::span<const ModelElement<T>> elements) {
+            // Bulk insertions are always appended at the end of the model
+            const auto first = mModel.size() - elements.size();
+            mPositions.reserve(mModel.size());
+            for (std::size_t i = 0; i < elements.size(); i++)
+            {
+                insert(first + i);
+            }
+        })};
+
+        mConnections += {model.onElementModified([this](const uuids::uuid& uuid, const T&) {
+            if (auto index = mModel.index(uuid); index)
+            {
+                update(*index);
+            }
+        })};
+    }
+
+    /**
+     * Returns the elements of the view in order, nothing is copied.
+     */
+    [[nodiscard]] inline auto view() const
+    {
+        return mIndexes | std::views::transform([this](std::size_t index) -> const T& { return mModel[index]; });
+    }
+
+    /**
+     * Returns the model positions of the elements of the view, in order.
+     */
+    [[nodiscard]] inline const Indexes& indexes() const
+    {
+        return mIndexes;
+    }
+
+    [[nodiscard]] inline std::size_t size() const
+    {
+        return mIndexes.size();
+    }
+
+    [[nodiscard]] inline bool empty() const
+    {
+        return mIndexes.empty();
+    }
+
+    inline bool operator==(const ModelView&) const = delete;
+    ModelView& operator=(const ModelView&) = delete;
+    ModelView& operator=(ModelView&&) = delete;
+};
+
+#endif // MODELVIEW_HPP
@@ -0,0 +1,82 @@
+#ifndef ROMARCHIVE_HPP
+#define ROMARCHIVE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <ChefFun/Either.hh>
+
+#include "rom/file.hpp"
+
+namespace Rom {
+
+/**
+ * The outcome of auditing a rom archive against what the rom database expects it to contain.
+ * NOTE: Do not change numerical values of this enum, it is serialized and deserialized
+ * from the rom cache. By changing numerical values parsing will break.
+ */
+enum class Audit
+{
+    // Every expected member is available (or the archive is well formed when the database has no member list)
+    GOOD = 0,
+    // Some of the expected members are not in the archive
+    MISSING_FILES = 1,
+    // Some of the expected members are in the archive but with a wrong size or crc
+    BAD_FILES = 2,
+    // The archive is not a valid zip file
+    CORRUPTED = 3,
+    // The archive could not be opened
+    UNREADABLE = 4
+};
+
+/**
+ * This class lists the content of a zip archive without ever decompressing it.
+ * Only the end of central directory record and the central directory are read, which means that
+ * listing an archive costs a couple of page faults at its tail no matter how big the archive is.
+ */
+class Archive
+{
+ public:
+    enum class Error
+    {
+        OPEN_FILE,
+        MEMORY_MAP,
+        NO_END_OF_CENTRAL_DIRECTORY,
+        MALFORMED_CENTRAL_DIRECTORY
+    };
+
+    using Result = ChefFun::Either<Error, std::vector<Rom::File>>;
+
+ private:
+    // Provides "size" bytes of the archive starting at "offset", if available
+    using Reader = std::function<std::optional<std::span<const std::byte>>(std::uint64_t offset, std::uint64_t size)>;
+
+    [[nodiscard]] static Result members(std::uint64_t archiveSize, const Reader& reader);
+
+ public:
+    Archive() = delete;
+
+    /**
+     * Lists the members of the zip archive stored at the given path.
+     */
+    [[nodiscard]] static Result members(const std::filesystem::path& path);
+
+    /**
+     * Lists the members of a zip archive which is entirely available in memory.
+     */
+    [[nodiscard]] static Result members(std::span<const std::byte> archive);
+
+    /**
+     * Compares the members of an archive with the expected ones. Members are matched by name (case insensitively,
+     * as MAME does) and then by crc, so renamed dumps are still recognized.
+     */
+    [[nodiscard]] static Audit audit(const std::vector<Rom::File>& members, const std::vector<Rom::File>& expected);
+};
+} // namespace Rom
+
+#endif // ROMARCHIVE_HPP
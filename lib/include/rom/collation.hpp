@@ -0,0 +1,18 @@
+#ifndef ROMCOLLATION_HPP
+#define ROMCOLLATION_HPP
+
+#include <string>
+#include <string_view>
+
+namespace Rom {
+/**
+ * Builds the key a text should be sorted by, so that plain byte comparison of keys gives the order a human expects:
+ * - Case is folded
+ * - Leading punctuation and a leading english article ("The", "A", "An") are ignored
+ * - Numbers compare by value, so "Tekken 2" comes before "Tekken 10"
+ * Keys are meant to be compared with each other only, they are not readable text.
+ */
+[[nodiscard]] std::string collationKey(std::string_view text);
+} // namespace Rom
+
+#endif // ROMCOLLATION_HPP
@@ -0,0 +1,53 @@
+#ifndef ROMDEFINITION_HPP
+#define ROMDEFINITION_HPP
+
+#include <optional>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "rom/file.hpp"
+#include "rom/info.hpp"
+#include "utils.hpp"
+
+namespace Rom {
+
+/**
+ * What the rom database knows about a rom: its info plus the archive members MAME expects, when they are known.
+ * Members are only needed to audit a rom while scanning, games, libraries and caches only keep the resulting audit.
+ */
+struct Definition
+{
+    static constexpr std::string_view FILES_JSON_FIELD = "files";
+
+    Rom::Info info;
+    std::optional<std::vector<Rom::File>> files;
+
+    bool operator==(const Definition&) const = default;
+};
+
+// A definition is stored as its info with the member list alongside
+inline void to_json(nlohmann::json& json, const Rom::Definition& definition)
+{
+    json = definition.info;
+    utils::addOptionalToJson(json, Rom::Definition::FILES_JSON_FIELD, definition.files);
+}
+
+inline void from_json(const nlohmann::json& json, Rom::Definition& definition)
+{
+    definition.info = json.get<Rom::Info>();
+    definition.files =
+        utils::getOptionalValueFromJson<std::vector<Rom::File>>(json, Rom::Definition::FILES_JSON_FIELD);
+}
+} // namespace Rom
+
+template <> struct fmt::formatter<Rom::Definition> : fmt::formatter<Rom::Info>
+{
+    auto format(const Rom::Definition& definition, fmt::format_context& ctx) const -> fmt::format_context::iterator
+    {
+        return fmt::formatter<Rom::Info>::format(definition.info, ctx);
+    }
+};
+
+#endif // ROMDEFINITION_HPP
@@ -0,0 +1,48 @@
+#ifndef ROMFILE_HPP
+#define ROMFILE_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
+#include "utils.hpp"
+
+namespace Rom {
+
+/**
+ * A single member of a rom archive (eg: a rom chip dump stored inside a zip).
+ * It is described the same way MAME describes it: a name, an uncompressed size and a CRC32.
+ */
+struct File
+{
+    static constexpr std::string_view NAME_JSON_FIELD = "name";
+    static constexpr std::string_view SIZE_JSON_FIELD = "size";
+    static constexpr std::string_view CRC_JSON_FIELD = "crc";
+
+    std::string name;
+    std::uint64_t size = 0;
+    std::uint32_t crc = 0;
+
+    bool operator==(const File&) const = default;
+};
+
+inline void to_json(nlohmann::json& json, const Rom::File& file)
+{
+    json.clear();
+
+    json[Rom::File::NAME_JSON_FIELD] = file.name;
+    json[Rom::File::SIZE_JSON_FIELD] = file.size;
+    json[Rom::File::CRC_JSON_FIELD] = file.crc;
+}
+
+inline void from_json(const nlohmann::json& json, Rom::File& file)
+{
+    file.name = json.at(Rom::File::NAME_JSON_FIELD).get<std::string>();
+    file.size = json.at(Rom::File::SIZE_JSON_FIELD).get<std::uint64_t>();
+    file.crc = json.at(Rom::File::CRC_JSON_FIELD).get<std::uint32_t>();
+}
+} // namespace Rom
+
+#endif // ROMFILE_HPP
@@ -17,7 +17,6 @@ class Folder : public Source
 
  private:
     [[nodiscard]] std::vector<std::filesystem::path> scan() const override;
-    [[nodiscard]] std::vector<std::filesystem::path> fileList(const std::filesystem::path& folder) const;
     [[nodiscard]] std::optional<std::string> lastModified() const override;
 };
 } // namespace Rom
@@ -10,9 +10,12 @@
 #include <nlohmann/json_fwd.hpp>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include "database/table.hpp"
 #include "exception.hpp"
+#include "rom/archive.hpp"
+#include "rom/definition.hpp"
 #include "rom/info.hpp"
 #include "rom/media.hpp"
 #include "utils.hpp"
@@ -24,19 +27,24 @@ class Game
     std::filesystem::path mPath;
     Rom::Info mInfo;
     std::optional<Rom::Media> mMedia;
+    std::optional<Rom::Audit> mAudit;
 
  public:
     static constexpr std::string_view PATH_JSON_FIELD = "path";
     static constexpr std::string_view INFO_JSON_FIELD = "info";
     static constexpr std::string_view MEDIA_JSON_FIELD = "media";
+    static constexpr std::string_view AUDIT_JSON_FIELD = "audit";
 
     Game() = delete;
-    explicit Game(const std::filesystem::path& path, const Rom::Info& info,
-                  const std::optional<Rom::Media>& media = std::nullopt);
+    explicit Game(std::filesystem::path path, Rom::Info info, std::optional<Rom::Media> media = std::nullopt,
+                  std::optional<Rom::Audit> audit = std::nullopt);
 
-    [[nodiscard]] std::filesystem::path path() const;
-    [[nodiscard]] Rom::Info info() const;
-    [[nodiscard]] std::optional<Rom::Media> media() const;
+    // Accessors never copy, returned references live as long as the game does
+    [[nodiscard]] const std::filesystem::path& path() const;
+    [[nodiscard]] const Rom::Info& info() const;
+    [[nodiscard]] std::string_view title() const;
+    [[nodiscard]] const std::optional<Rom::Media>& media() const;
+    [[nodiscard]] std::optional<Rom::Audit> audit() const;
 
     [[nodiscard]] std::string toString() const;
 
@@ -44,7 +52,7 @@ class Game
 };
 
 static constexpr char dbPath[] = "romdb/romdb.json";
-using Database = Database::Table<std::string, Rom::Info, dbPath>;
+using Database = Database::Table<std::string, Rom::Definition, dbPath>;
 } // namespace Rom
 
 namespace nlohmann {
@@ -55,8 +63,9 @@ template <> struct adl_serializer<Rom::Game>
         auto romPath = json.at(Rom::Game::PATH_JSON_FIELD).get<std::filesystem::path>();
         auto romInfo = json.at(Rom::Game::INFO_JSON_FIELD).get<Rom::Info>();
         auto romMedia = utils::getOptionalValueFromJson<Rom::Media>(json, Rom::Game::MEDIA_JSON_FIELD);
+        auto romAudit = utils::getOptionalValueFromJson<Rom::Audit>(json, Rom::Game::AUDIT_JSON_FIELD);
 
-        Rom::Game rom(romPath, romInfo, romMedia);
+        Rom::Game rom(std::move(romPath), std::move(romInfo), std::move(romMedia), romAudit);
 
         return rom;
     }
@@ -73,6 +82,9 @@ template <> struct adl_serializer<Rom::Game>
 
         // Setting rom media
         utils::addOptionalToJson<Rom::Media>(json, Rom::Game::MEDIA_JSON_FIELD, rom.media());
+
+        // Setting rom audit
+        utils::addOptionalToJson<Rom::Audit>(json, Rom::Game::AUDIT_JSON_FIELD, rom.audit());
     }
 };
 } // namespace nlohmann
@@ -81,7 +93,7 @@ template <> struct fmt::formatter<Rom::Game> : fmt::formatter<string_view>
 {
     auto format(const Rom::Game& game, fmt::format_context& ctx) const -> fmt::format_context::iterator
     {
-        return fmt::formatter<string_view>::format(game.toString(), ctx);
+        return fmt::formatter<string_view>::format(game.title(), ctx);
     }
 };
 
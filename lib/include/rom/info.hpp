@@ -13,11 +13,16 @@ struct Info
     static constexpr std::string_view YEAR_JSON_FIELD = "year";
     static constexpr std::string_view MANUFACTURER_JSON_FIELD = "manufacturer";
     static constexpr std::string_view ISBIOS_JSON_FIELD = "isBios";
+    static constexpr std::string_view PARENT_JSON_FIELD = "parent";
+    static constexpr std::string_view BIOS_JSON_FIELD = "bios";
 
     std::string title;
     std::optional<std::string> year;
     std::optional<std::string> manufacturer;
     std::optional<bool> isBios;
+    // The sets MAME also reads when running this rom (eg: "sf2" for "sf2ce", "neogeo" for every Neo Geo game)
+    std::optional<std::string> parent;
+    std::optional<std::string> bios;
 
     [[nodiscard]] inline std::string toString() const
     {
@@ -40,6 +45,8 @@ inline void to_json(nlohmann::json& json, const Rom::Info& info)
     utils::addOptionalToJson(json, Rom::Info::YEAR_JSON_FIELD, info.year);
     utils::addOptionalToJson(json, Rom::Info::MANUFACTURER_JSON_FIELD, info.manufacturer);
     utils::addOptionalToJson(json, Rom::Info::ISBIOS_JSON_FIELD, info.isBios);
+    utils::addOptionalToJson(json, Rom::Info::PARENT_JSON_FIELD, info.parent);
+    utils::addOptionalToJson(json, Rom::Info::BIOS_JSON_FIELD, info.bios);
 }
 
 inline void from_json(const nlohmann::json& json, Rom::Info& info)
@@ -48,6 +55,8 @@ inline void from_json(const nlohmann::json& json, Rom::Info& info)
     info.year = utils::getOptionalValueFromJson<std::string>(json, Rom::Info::YEAR_JSON_FIELD);
     info.manufacturer = utils::getOptionalValueFromJson<std::string>(json, Rom::Info::MANUFACTURER_JSON_FIELD);
     info.isBios = utils::getOptionalValueFromJson<bool>(json, Rom::Info::ISBIOS_JSON_FIELD);
+    info.parent = utils::getOptionalValueFromJson<std::string>(json, Rom::Info::PARENT_JSON_FIELD);
+    info.bios = utils::getOptionalValueFromJson<std::string>(json, Rom::Info::BIOS_JSON_FIELD);
 }
 } // namespace Rom
 
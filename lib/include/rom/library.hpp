@@ -0,0 +1,221 @@
+#ifndef ROMLIBRARY_HPP
+#define ROMLIBRARY_HPP
+
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "rom/game.hpp"
+
+namespace Rom {
+
+/**
+ * A compact, columnar store for big rom collections.
+ * A Rom::Game owns a full path, three heap strings and an optional screenshot path: with tens of thousands of roms
+ * this means a lot of small allocations scattered all over the heap. This class instead keeps every field in its own
+ * contiguous column: file names and titles are packed in a single character buffer while directories, years and
+ * manufacturers (which are repeated over and over) are interned and referenced by id.
+ * Roms are accessed through Rom::Library::Entry, a lightweight handle which is just a pointer and an index.
+ * Collation keys (see Rom::collationKey) for titles and manufacturers are computed once, when a rom is added.
+ *
+ * Entries (and views returned by them) are valid as long as the library they come from is alive and not moved.
+ */
+class Library
+{
+ public:
+    using Index = std::uint32_t;
+
+ private:
+    static constexpr Index NONE = std::numeric_limits<Index>::max();
+
+    // A string stored in the library character buffer
+    struct Slice
+    {
+        Index offset;
+        Index length;
+    };
+
+    // Stores every distinct string once and hands out an id for it
+    class StringPool
+    {
+     private:
+        // A deque never moves its elements, so views into them can safely be used as keys
+        std::deque<std::string> mStrings;
+        std::unordered_map<std::string_view, Index> mIds;
+
+     public:
+        [[nodiscard]] Index intern(std::string_view string);
+        [[nodiscard]] inline std::string_view operator[](Index id) const
+        {
+            return mStrings[id];
+        }
+    };
+
+    std::string mCharacters;
+    StringPool mPool;
+
+    // Columns, one element per rom
+    std::vector<Index> mDirectories;
+    std::vector<Slice> mFileNames;
+    std::vector<Slice> mTitles;
+    std::vector<Slice> mTitleKeys;
+    std::vector<Index> mYears;
+    std::vector<Index> mManufacturers;
+    std::vector<Index> mManufacturerKeys;
+    std::vector<std::optional<bool>> mIsBios;
+    std::vector<std::optional<Rom::Audit>> mAudits;
+    std::vector<Index> mParents;
+    std::vector<Index> mBioses;
+    std::vector<Index> mScreenshotDirectories;
+    std::vector<Slice> mScreenshotNames;
+
+    [[nodiscard]] Slice store(std::string_view string);
+    [[nodiscard]] std::string_view view(const Slice& slice) const;
+    [[nodiscard]] Index intern(const std::optional<std::string>& string);
+    [[nodiscard]] std::optional<std::string_view> interned(Index id) const;
+
+ public:
+    class Entry
+    {
+     private:
+        const Library* mLibrary;
+        Index mIndex;
+
+     public:
+        inline Entry(const Library& library, Index index) : mLibrary(&library), mIndex(index) {}
+
+        [[nodiscard]] inline Index index() const
+        {
+            return mIndex;
+        }
+
+        [[nodiscard]] std::filesystem::path path() const;
+        [[nodiscard]] std::string_view fileName() const;
+        [[nodiscard]] std::string_view stem() const;
+        [[nodiscard]] std::string_view title() const;
+        [[nodiscard]] std::string_view titleKey() const;
+        [[nodiscard]] std::optional<std::string_view> year() const;
+        [[nodiscard]] std::optional<std::string_view> manufacturer() const;
+        [[nodiscard]] std::optional<std::string_view> manufacturerKey() const;
+        [[nodiscard]] std::optional<std::filesystem::path> screenshot() const;
+        [[nodiscard]] std::optional<Rom::Audit> audit() const;
+        [[nodiscard]] std::optional<std::string_view> parent() const;
+        [[nodiscard]] std::optional<std::string_view> bios() const;
+
+        /**
+         * Builds a standalone Rom::Game out of this entry.
+         */
+        [[nodiscard]] Rom::Game game() const;
+
+        [[nodiscard]] inline bool operator==(const Entry& entry) const
+        {
+            return mLibrary == entry.mLibrary && mIndex == entry.mIndex;
+        }
+    };
+
+    class Iterator
+    {
+     private:
+        const Library* mLibrary = nullptr;
+        Index mIndex = 0;
+
+     public:
+        // Entries are returned by value, that is why this is not a legacy forward iterator
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+        inline Iterator(const Library& library, Index index) : mLibrary(&library), mIndex(index) {}
+
+        [[nodiscard]] inline Entry operator*() const
+        {
+            return Entry(*mLibrary, mIndex);
+        }
+
+        inline Iterator& operator++()
+        {
+            ++mIndex;
+            return *this;
+        }
+
+        inline Iterator operator++(int)
+        {
+            auto result = *this;
+            ++mIndex;
+            return result;
+        }
+
+        [[nodiscard]] inline bool operator==(const Iterator& iterator) const
+        {
+            return mIndex == iterator.mIndex;
+        }
+    };
+
+    Library() = default;
+    Library(const Library& library) = delete;
+    Library(Library&& library) noexcept = default;
+
+    template <std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, const Rom::Game&>
+    explicit Library(const R& games)
+    {
+        if constexpr (std::ranges::sized_range<R>)
+        {
+            reserve(std::ranges::size(games));
+        }
+
+        for (const Rom::Game& game : games)
+        {
+            add(game);
+        }
+    }
+
+    void reserve(std::size_t size);
+    Index add(const Rom::Game& game);
+
+    [[nodiscard]] inline std::size_t size() const
+    {
+        return mTitles.size();
+    }
+
+    [[nodiscard]] inline bool empty() const
+    {
+        return mTitles.empty();
+    }
+
+    [[nodiscard]] inline Entry operator[](Index index) const
+    {
+        return Entry(*this, index);
+    }
+
+    [[nodiscard]] inline Iterator begin() const
+    {
+        return Iterator(*this, 0);
+    }
+
+    [[nodiscard]] inline Iterator end() const
+    {
+        return Iterator(*this, static_cast<Index>(size()));
+    }
+
+    /**
+     * Returns the indexes of every entry ordered by title. Only the title key column is touched while sorting.
+     */
+    [[nodiscard]] std::vector<Index> orderByTitle() const;
+
+    Library& operator=(const Library& library) = delete;
+    Library& operator=(Library&& library) noexcept = default;
+};
+} // namespace Rom
+
+#endif // ROMLIBRARY_HPP
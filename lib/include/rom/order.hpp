@@ -0,0 +1,24 @@
+#ifndef ROMORDER_HPP
+#define ROMORDER_HPP
+
+#include "rom/library.hpp"
+
+namespace Rom {
+
+// The orders a library can be shown in, entries equivalent for an order are then sorted by title
+enum class Sort
+{
+    TITLE,
+    YEAR,
+    MANUFACTURER
+};
+
+/**
+ * Returns true if the first entry comes before the second one in the given order, it only compares precomputed
+ * collation keys. Entries missing the sorting field (eg: an unknown year) come last.
+ * Entries with the very same title are equivalent, callers which need a deterministic order have to break the tie.
+ */
+[[nodiscard]] bool precedes(Rom::Sort sort, const Rom::Library::Entry& first, const Rom::Library::Entry& second);
+} // namespace Rom
+
+#endif // ROMORDER_HPP
@@ -0,0 +1,88 @@
+#ifndef ROMPREFETCHER_HPP
+#define ROMPREFETCHER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rom/library.hpp"
+
+namespace Rom {
+
+/**
+ * Warms the page cache with the archives a rom is about to be launched from, so advmame does not wait for a slow
+ * sd card or usb stick when it first reads them.
+ * Files are read ahead from a background thread with the idle I/O priority, a chunk at a time: a new request cancels
+ * the previous one within a chunk, and no request reads more than a fixed amount of bytes. Scrolling through the
+ * menu can't keep the disk busy.
+ * Only Linux is supported, elsewhere requests are ignored.
+ */
+class Prefetcher
+{
+ public:
+    static constexpr std::uint64_t DEFAULT_BUDGET = 64 * 1024 * 1024;
+    static constexpr std::uint64_t CHUNK = 1024 * 1024;
+
+ private:
+    std::uint64_t mBudget;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::vector<std::filesystem::path> mFiles;
+    // Bumped by every request (and cancellation), the worker drops what it is doing as soon as it changes
+    std::atomic<std::uint64_t> mGeneration = 0;
+    std::uint64_t mDone = 0;
+    bool mStopping = false;
+    std::atomic<std::uint64_t> mPrefetched = 0;
+    std::thread mWorker;
+
+    void work();
+    void prefetch(const std::filesystem::path& file, std::uint64_t generation, std::uint64_t& budget);
+
+ public:
+    explicit Prefetcher(std::uint64_t budget = DEFAULT_BUDGET);
+    Prefetcher(const Prefetcher& prefetcher) = delete;
+    Prefetcher(Prefetcher&& prefetcher) = delete;
+
+    /**
+     * The archive of rom together with the ones of its parent and bios sets, when they are known and found next to
+     * it (that is where advmame looks for them).
+     * The bundled db/romdb.json predates the parent and bios fields: until it is regenerated with
+     * scripts/generate_romdb.py only the archive of rom itself is returned.
+     */
+    [[nodiscard]] static std::vector<std::filesystem::path> files(const Rom::Library::Entry& rom);
+
+    /**
+     * Reads files ahead, in order, in place of whatever was being read ahead before.
+     */
+    void prefetch(std::vector<std::filesystem::path> files);
+
+    /**
+     * Stops reading ahead as soon as the current chunk is done.
+     */
+    void cancel();
+
+    /**
+     * Blocks until the last request is done or cancelled.
+     */
+    void wait();
+
+    /**
+     * Bytes read ahead since this prefetcher was created.
+     */
+    [[nodiscard]] inline std::uint64_t prefetched() const
+    {
+        return mPrefetched;
+    }
+
+    Prefetcher& operator=(const Prefetcher& prefetcher) = delete;
+    Prefetcher& operator=(Prefetcher&& prefetcher) = delete;
+
+    ~Prefetcher();
+};
+} // namespace Rom
+
+#endif // ROMPREFETCHER_HPP
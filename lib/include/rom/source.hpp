@@ -1,26 +1,38 @@
 #ifndef ROMSOURCE_HPP
 #define ROMSOURCE_HPP
 
-#include "model.hpp"
+#include <mutex>
+
 #include "rom/game.hpp"
+#include "rom/library.hpp"
 #include "softwareinfo.hpp"
+#include "utils/snapshot.hpp"
+
+namespace Bench {
+class Pipeline;
+} // namespace Bench
 
 namespace Rom {
 
-class Source : public Model<Game>
+class Source
 {
+    // Lets the benchmark run the single phases of a source lifecycle (scan, parse, ...) one by one
+    friend class Bench::Pipeline;
+
  private:
     std::string mIdentifier;
     std::once_flag mMonitorCalled;
     bool mMonitored = false;
     mutable std::optional<std::string> mLastModified;
     std::filesystem::path mCacheFile;
+    Snapshot<Rom::Library> mLibrary;
 
     [[nodiscard]] virtual std::vector<std::filesystem::path> scan() const = 0;
     [[nodiscard]] virtual std::vector<Game> parse() const final;
     [[nodiscard]] virtual std::optional<std::vector<Game>> cache() const final;
     [[nodiscard]] virtual std::optional<std::string> lastModified() const = 0;
-    [[nodiscard]] virtual std::optional<Rom::Info> romInfo(const std::filesystem::path& path) const;
+    [[nodiscard]] virtual std::optional<Rom::Definition> definition(const std::filesystem::path& path) const;
+    [[nodiscard]] virtual Rom::Audit audit(const std::filesystem::path& path, const Rom::Definition& definition) const;
     [[nodiscard]] virtual std::optional<nlohmann::json> readCacheFile(const std::filesystem::path& path) const;
     [[nodiscard]] virtual bool writeCacheFile(const nlohmann::json& json, const std::filesystem::path& path) const;
     [[nodiscard]] virtual inline std::string_view version() const
@@ -42,6 +54,15 @@ class Source : public Model<Game>
     virtual void monitor() final;
     [[nodiscard]] virtual bool writeCache() const final;
 
+    /**
+     * The roms of this source as an immutable library, a new version is published every time the source changes.
+     * This is where the roms of a source are stored, it can be safely read from any thread.
+     */
+    [[nodiscard]] inline const Snapshot<Rom::Library>& library() const
+    {
+        return mLibrary;
+    }
+
     virtual ~Source() = default;
 };
 } // namespace Rom
@@ -0,0 +1,106 @@
+#ifndef SCHEDULINGPOLICY_HPP
+#define SCHEDULINGPOLICY_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#ifdef TARGET_OS_LINUX
+#include <sys/types.h>
+#endif
+
+#include "utils.hpp"
+
+/**
+ * How the emulator process is scheduled and how it is kept apart from Enea itself.
+ * Every setting is optional, what is not set is left as the system decides. Settings which can't be applied (eg:
+ * a negative niceness without the needed privileges) are reported in the logs and skipped, they never prevent a
+ * game from starting.
+ */
+struct SchedulingPolicy
+{
+    // Named after the Linux scheduling policies (SCHED_*)
+    enum class Scheduler
+    {
+        OTHER,
+        BATCH,
+        IDLE,
+        FIFO,
+        RR
+    };
+
+    // Named after the Linux resource limits (RLIMIT_*)
+    enum class Limit
+    {
+        AS,
+        CORE,
+        MEMLOCK,
+        NOFILE,
+        RTPRIO
+    };
+
+    static constexpr std::string_view EMULATORCORES_JSON_FIELD = "emulatorCores";
+    static constexpr std::string_view ENEACORES_JSON_FIELD = "eneaCores";
+    static constexpr std::string_view NICENESS_JSON_FIELD = "niceness";
+    static constexpr std::string_view SCHEDULER_JSON_FIELD = "scheduler";
+    static constexpr std::string_view PRIORITY_JSON_FIELD = "priority";
+    static constexpr std::string_view LIMITS_JSON_FIELD = "limits";
+    static constexpr std::string_view CGROUP_JSON_FIELD = "cgroup";
+    static constexpr std::string_view CGROUPSETTINGS_JSON_FIELD = "cgroupSettings";
+
+    // Cores the emulator runs on
+    std::optional<std::vector<unsigned int>> emulatorCores;
+    // Cores Enea (and every thread it starts) runs on
+    std::optional<std::vector<unsigned int>> eneaCores;
+    std::optional<int> niceness;
+    std::optional<Scheduler> scheduler;
+    // Only meaningful with the FIFO and RR schedulers
+    std::optional<int> priority;
+    std::map<Limit, std::uint64_t> limits;
+    // A cgroup v2 directory (eg: /sys/fs/cgroup/enea/emulator) the emulator is moved into, created if needed
+    std::optional<std::filesystem::path> cgroup;
+    // Interface files written in the cgroup before moving the emulator into it (eg: "cpu.weight": "1000")
+    std::map<std::string, std::string> cgroupSettings;
+
+    /**
+     * Reads a policy from a json file. A missing or malformed file gives the default policy, which changes nothing.
+     */
+    [[nodiscard]] static SchedulingPolicy fromFile(const std::filesystem::path& path);
+
+    /**
+     * Pins the calling thread to eneaCores, if any. Called before any other thread is started, every thread of the
+     * process inherits it.
+     */
+    void pinEnea() const;
+
+#ifdef TARGET_OS_LINUX
+    /**
+     * Applies the emulator settings to a freshly started process.
+     */
+    void apply(pid_t pid) const;
+#endif
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] std::string toString() const;
+
+    bool operator==(const SchedulingPolicy&) const = default;
+};
+
+void to_json(nlohmann::json& json, const SchedulingPolicy& policy);
+void from_json(const nlohmann::json& json, SchedulingPolicy& policy);
+
+template <> struct fmt::formatter<SchedulingPolicy> : fmt::formatter<string_view>
+{
+    auto format(const SchedulingPolicy& policy, fmt::format_context& ctx) const -> fmt::format_context::iterator
+    {
+        return fmt::formatter<string_view>::format(policy.toString(), ctx);
+    }
+};
+
+#endif // SCHEDULINGPOLICY_HPP
@@ -4,7 +4,22 @@
 #include <ChefFun/Either.hh>
 #include <System2.hpp>
 
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef TARGET_OS_LINUX
+#include <sys/types.h>
+#endif
+
+#include "utils/ringbuffer.hpp"
 
 class SystemCommand
 {
@@ -21,8 +36,120 @@ class SystemCommand
         LAUNCH_COMMAND,
     };
 
+    // Environment variables handed to a command, by name
+    using Environment = std::map<std::string, std::string>;
+
+    /**
+     * How the output of a spawned command is captured. Memory use does not depend on how much the command writes:
+     * only the last limit bytes are kept and returned as its output, lines longer than that are cut.
+     * Every line is handed to onLine as soon as it is read. The whole output can also be written to logFile (which is
+     * overwritten) from a background thread.
+     */
+    struct Capture
+    {
+        static constexpr std::size_t DEFAULT_LIMIT = 64 * 1024;
+
+        std::size_t limit = DEFAULT_LIMIT;
+        std::function<void(std::string_view line)> onLine;
+        std::optional<std::filesystem::path> logFile;
+    };
+
+    /**
+     * A command running in background, obtained through SystemCommand::spawn.
+     * Nothing here blocks unless explicitly stated: the owner is supposed to poll it (eg: once per frame) until it
+     * reports the command exited. Output is captured as described in SystemCommand::Capture.
+     * Destroying a process which is still running cancels it without blocking, see ~Process().
+     */
+    class Process
+    {
+        friend class SystemCommand;
+
+     public:
+        static constexpr std::chrono::milliseconds DEFAULT_CANCEL_TIMEOUT{2000};
+
+     private:
+        // Writes output to the log file, defined in the translation unit
+        class Spill;
+
+        std::string mCmd;
+        RingBuffer mOutput;
+        std::function<void(std::string_view line)> mOnLine;
+        std::string mLine;
+        std::unique_ptr<Spill> mSpill;
+        std::optional<int> mExitCode;
+
+        void openLog(const std::optional<std::filesystem::path>& logFile);
+        void consume(std::string_view chunk);
+        void flushLine();
+
+#ifdef TARGET_OS_LINUX
+        pid_t mPid;
+        int mOutputFd;
+        // Only for commands spawned by the launcher helper: they are not our children, their wait status is read here
+        int mStatusFd;
+
+        explicit Process(const std::string& cmd, Capture&& capture, pid_t pid, int outputFd, int statusFd);
+        void readOutput(bool untilEnd);
+        void reap(bool blocking);
+#elif defined(TARGET_OS_WINDOWS)
+        // System2 has no way to check on a command without blocking, so it is waited on from another thread
+        std::future<ChefFun::Either<SYSTEM2_RESULT, Output>> mResult;
+
+        explicit Process(const std::string& cmd, Capture&& capture,
+                         std::future<ChefFun::Either<SYSTEM2_RESULT, Output>>&& result);
+        void collect();
+#else
+#error "Unknown target OS. Compilation halted."
+#endif
+
+     public:
+        Process() = delete;
+        Process(const Process& process) = delete;
+        Process(Process&& process) = delete;
+
+        /**
+         * Reads any output available and checks if the command exited, never blocks.
+         * Returns the command result once it exited.
+         */
+        [[nodiscard]] std::optional<Output> poll();
+
+        /**
+         * Blocks until the command exits and returns its result.
+         */
+        [[nodiscard]] Output wait();
+
+        /**
+         * Asks the command to terminate and waits up to timeout for it to comply, after that it is killed.
+         * Returns true if the command exited on its own terms.
+         */
+        bool cancel(std::chrono::milliseconds timeout = DEFAULT_CANCEL_TIMEOUT);
+
+        [[nodiscard]] inline bool running() const
+        {
+            return !mExitCode.has_value();
+        }
+
+#ifdef TARGET_OS_LINUX
+        [[nodiscard]] inline pid_t pid() const
+        {
+            return mPid;
+        }
+#endif
+
+        Process& operator=(const Process& process) = delete;
+        Process& operator=(Process&& process) = delete;
+
+        /**
+         * Never blocks. A command still running is asked to terminate, it is then waited on and killed if needed after
+         * DEFAULT_CANCEL_TIMEOUT from a background thread.
+         */
+        ~Process();
+    };
+
  private:
     std::string mCmd;
+    std::vector<std::string> mArguments;
+    std::optional<Environment> mEnvironment;
 
     // here so we can easily gmock it
     [[nodiscard]] virtual ChefFun::Either<SYSTEM2_RESULT, Output> launchCmd() const;
@@ -33,8 +160,27 @@ class SystemCommand
     SystemCommand(SystemCommand&& cmd) = delete;
     inline explicit SystemCommand(const std::string& cmd) : mCmd(cmd) {}
 
+    /**
+     * A command given as an argument vector is started directly, without going through a shell: every argument reaches
+     * the command untouched (spaces included) and the first one is searched in PATH.
+     * Without an environment the command inherits the one of this process, otherwise it gets exactly the given
+     * variables (see SystemCommand::environment to amend the current one).
+     */
+    explicit SystemCommand(std::vector<std::string> arguments, std::optional<Environment> environment = std::nullopt);
+
+    /**
+     * The environment of this process.
+     */
+    [[nodiscard]] static Environment environment();
+
     [[nodiscard]] ChefFun::Either<Error, Output> launch() const;
 
+    /**
+     * Starts the command without waiting for it, see SystemCommand::Process.
+     */
+    [[nodiscard]] ChefFun::Either<Error, std::shared_ptr<Process>> spawn(Capture capture) const;
+    [[nodiscard]] ChefFun::Either<Error, std::shared_ptr<Process>> spawn() const;
+
     SystemCommand& operator=(const SystemCommand& cmd) = delete;
     SystemCommand& operator=(SystemCommand&& cmd) = delete;
 
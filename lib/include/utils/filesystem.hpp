@@ -0,0 +1,50 @@
+#ifndef UTILSFILESYSTEM_HPP
+#define UTILSFILESYSTEM_HPP
+
+#include <filesystem>
+#include <vector>
+
+namespace utils::filesystem {
+/*
+    We provide two different implementations to iterate over the content of a folder:
+    1. The first one uses POSIX API
+    2. The second one uses std::filesystem::recursive_directory_iterator
+
+    For some reasons our toolchain adds some strange symbols when using recursive_directory_iterator.
+    These symbols are generally unavailable on raspbian (?) and this makes the executable unusable.
+    For this reason we use the POSIX API when compiling arm so we don't break raspbian compatibility.
+    This issue should be investigated.
+
+    Both of them are exposed so they can be benchmarked against each other, fileList picks the one
+    selected at build time.
+*/
+
+#ifdef TARGET_OS_LINUX
+/**
+ * Recursively lists every file and folder contained into a folder using the POSIX API.
+ */
+[[nodiscard]] std::vector<std::filesystem::path> posixFileList(const std::filesystem::path& folder);
+#endif
+
+#ifndef USE_POSIX_FILE_LIST
+/**
+ * Recursively lists every file and folder contained into a folder using std::filesystem.
+ */
+[[nodiscard]] std::vector<std::filesystem::path> stdFileList(const std::filesystem::path& folder);
+#endif
+
+/**
+ * Recursively lists every file and folder contained into a folder using the implementation
+ * selected at build time.
+ */
+[[nodiscard]] inline std::vector<std::filesystem::path> fileList(const std::filesystem::path& folder)
+{
+#ifdef USE_POSIX_FILE_LIST
+    return posixFileList(folder);
+#else
+    return stdFileList(folder);
+#endif
+}
+} // namespace utils::filesystem
+
+#endif // UTILSFILESYSTEM_HPP
@@ -0,0 +1,92 @@
+#ifndef UTILSRINGBUFFER_HPP
+#define UTILSRINGBUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * This is an helper class keeping the last bytes written to it, up to a fixed capacity.
+ * Older bytes are overwritten as newer ones come in: memory is allocated once, the first time something is written,
+ * and never grows no matter how much is written.
+ */
+class RingBuffer
+{
+ private:
+    std::size_t mCapacity;
+    std::vector<char> mBuffer;
+    // Where the next byte goes and how many bytes are stored
+    std::size_t mHead = 0;
+    std::size_t mSize = 0;
+    std::size_t mDropped = 0;
+
+ public:
+    RingBuffer() = delete;
+    inline explicit RingBuffer(std::size_t capacity) : mCapacity(capacity) {}
+
+    inline void append(std::string_view data)
+    {
+        if (mCapacity == 0)
+        {
+            mDropped += data.size();
+            return;
+        }
+
+        if (mBuffer.empty())
+        {
+            mBuffer.resize(mCapacity);
+        }
+
+        // Only the tail of data can survive anyway
+        if (data.size() > mCapacity)
+        {
+            mDropped += data.size() - mCapacity;
+            data.remove_prefix(data.size() - mCapacity);
+        }
+
+        mDropped += std::max(mSize + data.size(), mCapacity) - mCapacity;
+        mSize = std::min(mSize + data.size(), mCapacity);
+
+        // At most two copies, before and after wrapping around
+        auto first = std::min(data.size(), mCapacity - mHead);
+        std::copy_n(data.begin(), first, mBuffer.begin() + static_cast<std::ptrdiff_t>(mHead));
+        std::copy(data.begin() + static_cast<std::ptrdiff_t>(first), data.end(), mBuffer.begin());
+        mHead = (mHead + data.size()) % mCapacity;
+    }
+
+    /**
+     * The bytes currently stored, oldest first.
+     */
+    [[nodiscard]] inline std::string str() const
+    {
+        std::string result;
+        result.reserve(mSize);
+        auto start = (mHead + mCapacity - mSize) % std::max<std::size_t>(mCapacity, 1);
+        auto first = std::min(mSize, mCapacity - start);
+        result.append(mBuffer.data() + start, first);
+        result.append(mBuffer.data(), mSize - first);
+        return result;
+    }
+
+    [[nodiscard]] inline std::size_t size() const
+    {
+        return mSize;
+    }
+
+    [[nodiscard]] inline std::size_t capacity() const
+    {
+        return mCapacity;
+    }
+
+    /**
+     * How many bytes were overwritten (or never stored) so far.
+     */
+    [[nodiscard]] inline std::size_t dropped() const
+    {
+        return mDropped;
+    }
+};
+
+#endif // UTILSRINGBUFFER_HPP
@@ -0,0 +1,107 @@
+#ifndef UTILSSNAPSHOT_HPP
+#define UTILSSNAPSHOT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+/**
+ * This is an helper class to share a value between one writer and many reader threads, RCU style.
+ * The writer never modifies a published value: it builds a brand new immutable version and publishes it.
+ * Readers keep using the version they grabbed for as long as they want, old versions are freed as soon as their
+ * last reader drops them.
+ * Reading through a Snapshot::Reader costs a single atomic load as long as nothing new was published, so it is
+ * fine to refresh it every frame.
+ */
+template <typename T> class Snapshot
+{
+ private:
+    // Only held to copy or swap a pointer, never while building or destroying a version
+    mutable std::mutex mMutex;
+    std::shared_ptr<const T> mCurrent;
+    std::atomic<std::uint64_t> mVersion = 0;
+
+    [[nodiscard]] inline std::pair<std::shared_ptr<const T>, std::uint64_t> current() const
+    {
+        std::scoped_lock lock(mMutex);
+        return {mCurrent, mVersion.load(std::memory_order_relaxed)};
+    }
+
+ public:
+    class Reader
+    {
+     private:
+        const Snapshot* mSnapshot;
+        std::shared_ptr<const T> mCurrent;
+        std::uint64_t mVersion = 0;
+
+     public:
+        Reader() = delete;
+        explicit inline Reader(const Snapshot& snapshot) : mSnapshot(&snapshot)
+        {
+            std::ignore = refresh();
+        }
+
+        /**
+         * Grabs the latest published version, if it is not the one we already hold.
+         * Returns true if a new version was grabbed.
+         */
+        [[nodiscard]] inline bool refresh()
+        {
+            if (mSnapshot->version() == mVersion)
+            {
+                return false;
+            }
+
+            std::tie(mCurrent, mVersion) = mSnapshot->current();
+            return true;
+        }
+
+        /**
+         * The version currently held, it stays valid until the next refresh even if something new is published.
+         * It is empty if nothing was published yet.
+         */
+        [[nodiscard]] inline const std::shared_ptr<const T>& get() const
+        {
+            return mCurrent;
+        }
+    };
+
+    Snapshot() = default;
+    Snapshot(const Snapshot&) = delete;
+    Snapshot(Snapshot&&) = delete;
+
+    /**
+     * Makes the given value the latest version. The previously published version, if nobody is using it anymore,
+     * is destroyed here and not while holding the lock.
+     */
+    inline void publish(std::shared_ptr<const T> value)
+    {
+        {
+            std::scoped_lock lock(mMutex);
+            mCurrent.swap(value);
+            mVersion.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    [[nodiscard]] inline std::shared_ptr<const T> load() const
+    {
+        return current().first;
+    }
+
+    /**
+     * A counter incremented on every publish, useful to cheaply know if something new is available.
+     */
+    [[nodiscard]] inline std::uint64_t version() const
+    {
+        return mVersion.load(std::memory_order_acquire);
+    }
+
+    Snapshot& operator=(const Snapshot&) = delete;
+    Snapshot& operator=(Snapshot&&) = delete;
+};
+
+#endif // UTILSSNAPSHOT_HPP
@@ -83,6 +83,31 @@ std::filesystem::path Conf::advMameConfigurationFile() const
     return baseDirectory() / "advmame.rc";
 }
 
+std::filesystem::path Conf::emulatorLogFile() const
+{
+    return baseDirectory() / "advmame.log";
+}
+
+std::filesystem::path Conf::schedulingPolicyFile() const
+{
+    return baseDirectory() / "scheduling.json";
+}
+
+std::filesystem::path Conf::benchmarkFile() const
+{
+    return cacheDirectory() / "benchmarks.json";
+}
+
+std::filesystem::path Conf::hardwareFile() const
+{
+    return cacheDirectory() / "hardware.json";
+}
+
+std::filesystem::path Conf::launchHistogramFile() const
+{
+    return baseDirectory() / "launch_latency.json";
+}
+
 Conf::RenderMode Conf::availableRenderMode() const
 {
 #ifdef USE_DIRECT_RENDERING
@@ -1,14 +1,58 @@
 #include "emulator.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <thread>
 
 #include <fmt/format.h>
 #include <magic_enum.hpp>
+#include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
 #include "configuration.hpp"
+#include "schedulingpolicy.hpp"
 #include "systemcommand.hpp"
 
+namespace {
+std::vector<std::string> command(const std::vector<std::string>& arguments)
+{
+    std::vector<std::string> result{"advmame"};
+    result.insert(result.end(), arguments.begin(), arguments.end());
+    return result;
+}
+
+// Looks for the last "speed ... NN.NN%" advmame printed, eg: "Average speed: 187.32%"
+std::optional<double> reportedSpeed(std::string_view output)
+{
+    auto label = output.rfind("speed");
+    if (label == std::string_view::npos)
+    {
+        return std::nullopt;
+    }
+
+    auto begin = output.find_first_of("0123456789", label);
+    auto end = output.find('%', label);
+    if (begin == std::string_view::npos || end == std::string_view::npos || end < begin)
+    {
+        return std::nullopt;
+    }
+
+    const std::string number(output.substr(begin, end - begin));
+    char* parsed = nullptr;
+    auto speed = std::strtod(number.c_str(), &parsed);
+    if (parsed != number.c_str() + number.size())
+    {
+        return std::nullopt;
+    }
+
+    return speed;
+}
+} // namespace
+
 bool Emulator::romExists(const Rom::Game& rom) const
 {
     return std::filesystem::is_regular_file(rom.path());
@@ -23,7 +67,7 @@ bool Emulator::romIsReadable(const Rom::Game& rom) const
             (perms & fs::perms::others_read) != fs::perms::none);
 }
 
-std::optional<Emulator::Error> Emulator::run(const Rom::Game& rom, const std::string& inputString) const
+std::optional<Emulator::Error> Emulator::validate(const Rom::Game& rom) const
 {
     // Checking if the file exists
     if (!romExists(rom))
@@ -38,38 +82,196 @@ std::optional<Emulator::Error> Emulator::run(const Rom::Game& rom, const std::st
     }
 
     // Checking if the file has stem and parent path
-    auto romPath = rom.path();
+    const auto& romPath = rom.path();
     if (!romPath.has_stem() || !romPath.has_parent_path())
     {
         return Emulator::Error::ROM_PATH_INVALID;
     }
 
+    return std::nullopt;
+}
+
+ChefFun::Either<Emulator::Error, std::vector<std::string>> Emulator::arguments(const Rom::Game& rom,
+                                                                              const std::string& inputString) const
+{
+    using Result = ChefFun::Either<Error, std::vector<std::string>>;
+
+    if (auto error = validate(rom); error)
+    {
+        return Result::Left(*error);
+    }
+
     // If there is no input available we exit with an error
     if (inputString.empty())
     {
-        return Emulator::Error::NO_VALID_INPUT;
+        return Result::Left(Emulator::Error::NO_VALID_INPUT);
+    }
+
+    // Every argument is handed to advmame as is, so paths with spaces need no quoting
+    std::vector<std::string> result{"-cfg",
+                                    Configuration::get().advMameConfigurationFile().string(),
+                                    "-misc_quiet",
+                                    "-nomisc_safequit",
+                                    "--device_video",
+                                    "sdl",
+                                    "--device_keyboard",
+                                    "sdl",
+                                    "--device_joystick",
+                                    "sdl"};
+
+    // The input string is a list of options separated by spaces (see Input::Manager::controlString)
+    std::string_view options(inputString);
+    while (!options.empty())
+    {
+        auto separator = std::min(options.find(' '), options.size());
+        if (separator != 0)
+        {
+            result.emplace_back(options.substr(0, separator));
+        }
+        options.remove_prefix(std::min(separator + 1, options.size()));
+    }
+
+    const auto& romPath = rom.path();
+    result.insert(result.end(), {"-dir_rom", romPath.parent_path().string(), romPath.stem().string()});
+    return Result::Right(std::move(result));
+}
+
+ChefFun::Either<Emulator::Error, std::vector<std::string>> Emulator::benchmarkArguments(const Rom::Game& rom,
+                                                                                       std::uint32_t seconds) const
+{
+    using Result = ChefFun::Either<Error, std::vector<std::string>>;
+
+    if (auto error = validate(rom); error)
+    {
+        return Result::Left(*error);
+    }
+
+    // advmame runs at full throttle for its whole startup time, making that as long as the run disables throttling
+    const auto& romPath = rom.path();
+    const auto time = std::to_string(seconds);
+    return Result::Right(std::vector<std::string>{"-cfg",
+                                                  Configuration::get().advMameConfigurationFile().string(),
+                                                  "-misc_quiet",
+                                                  "-nomisc_safequit",
+                                                  "--device_video",
+                                                  "sdl",
+                                                  "--device_sound",
+                                                  "none",
+                                                  "-sync_startuptime",
+                                                  time,
+                                                  "-misc_timetorun",
+                                                  time,
+                                                  "-dir_rom",
+                                                  romPath.parent_path().string(),
+                                                  romPath.stem().string()});
+}
+
+std::optional<Emulator::Error> Emulator::run(const Rom::Game& rom, const std::string& inputString) const
+{
+    auto cmdString = arguments(rom, inputString);
+    if (cmdString.isLeft())
+    {
+        return cmdString.getLeft();
     }
 
     // Launching emulator
-    auto cmdString = fmt::format("-cfg {} -misc_quiet -nomisc_safequit --device_video sdl --device_keyboard sdl "
-                                 "--device_joystick sdl {} -dir_rom {} {}",
-                                 Configuration::get().advMameConfigurationFile().string(), inputString,
-                                 romPath.parent_path().string(), romPath.stem().string());
+    return launch(cmdString.getRight())
+        .matchRight([](auto&& output) { return std::nullopt; })
+        .matchLeft([](auto&& error) { return std::optional<Emulator::Error>(Emulator::Error::EMULATOR_ERROR); });
+}
 
-    return launch(cmdString).matchRight([](auto&& output) { return std::nullopt; }).matchLeft([](auto&& error) {
-        return std::optional<Emulator::Error>(Emulator::Error::EMULATOR_ERROR);
-    });
+ChefFun::Either<Emulator::Error, std::shared_ptr<SystemCommand::Process>>
+Emulator::start(const Rom::Game& rom, const std::string& inputString) const
+{
+    LaunchTimeline timeline;
+    return start(rom, inputString, timeline);
+}
+
+ChefFun::Either<Emulator::Error, std::shared_ptr<SystemCommand::Process>>
+Emulator::start(const Rom::Game& rom, const std::string& inputString, LaunchTimeline& timeline) const
+{
+    using Result = ChefFun::Either<Error, std::shared_ptr<SystemCommand::Process>>;
+
+    auto cmdString = arguments(rom, inputString);
+    if (cmdString.isLeft())
+    {
+        return Result::Left(cmdString.getLeft());
+    }
+    timeline.mark(LaunchTimeline::Phase::ROM_VALIDATED);
+
+    // Launching emulator in background
+    auto process = spawn(cmdString.getRight());
+    if (process.isLeft())
+    {
+        return Result::Left(Emulator::Error::EMULATOR_ERROR);
+    }
+    timeline.mark(LaunchTimeline::Phase::PROCESS_SPAWNED);
+
+    return Result::Right(process.getRight());
 }
 
-ChefFun::Either<SystemCommand::Error, SystemCommand::Output> Emulator::launch(const std::string& arguments) const
+ChefFun::Either<SystemCommand::Error, SystemCommand::Output>
+Emulator::launch(const std::vector<std::string>& arguments) const
 {
-    SystemCommand cmd(fmt::format("advmame {}", arguments));
+    SystemCommand cmd(command(arguments));
     return cmd.launch();
 }
 
+ChefFun::Either<SystemCommand::Error, SystemCommand::Output>
+Emulator::launchHeadless(const std::vector<std::string>& arguments, std::chrono::milliseconds timeout) const
+{
+    using Result = ChefFun::Either<SystemCommand::Error, SystemCommand::Output>;
+    static constexpr std::chrono::milliseconds CHECK_INTERVAL{50};
+
+    // SDL draws in memory instead of opening a window, every frame is still rendered
+    auto environment = SystemCommand::environment();
+    environment["SDL_VIDEODRIVER"] = "dummy";
+
+    SystemCommand cmd(command(arguments), std::move(environment));
+    auto process = cmd.spawn();
+    if (process.isLeft())
+    {
+        return Result::Left(process.getLeft());
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (auto output = process.getRight()->poll(); output)
+        {
+            return Result::Right(std::move(*output));
+        }
+
+        std::this_thread::sleep_for(CHECK_INTERVAL);
+    }
+
+    spdlog::warn("Emulator did not finish in {}ms, cancelling it", timeout.count());
+    process.getRight()->cancel();
+    return Result::Left(SystemCommand::Error::LAUNCH_COMMAND);
+}
+
+ChefFun::Either<SystemCommand::Error, std::shared_ptr<SystemCommand::Process>>
+Emulator::spawn(const std::vector<std::string>& arguments) const
+{
+    // A whole game session can be long and advmame is chatty: we keep the tail in memory, the rest goes to its log
+    SystemCommand cmd(command(arguments));
+    auto process = cmd.spawn(SystemCommand::Capture{.onLine = [](auto line) { spdlog::debug("advmame: {}", line); },
+                                                    .logFile = Configuration::get().emulatorLogFile()});
+
+#ifdef TARGET_OS_LINUX
+    // Read at every launch, so the policy can be tuned without restarting Enea
+    if (process.isRight())
+    {
+        SchedulingPolicy::fromFile(Configuration::get().schedulingPolicyFile()).apply(process.getRight()->pid());
+    }
+#endif
+
+    return process;
+}
+
 std::optional<Emulator::EmulatorInfo> Emulator::info() const
 {
-    auto result = launch("-version");
+    auto result = launch({"-version"});
     if (result.isLeft())
     {
         return std::nullopt;
@@ -100,3 +302,235 @@ std::optional<Emulator::EmulatorInfo> Emulator::info() const
     return std::optional<EmulatorInfo>({result.getRight().output.substr(0, spacePos),
                                         result.getRight().output.substr(spacePos + 1, newlinePos - spacePos - 1)});
 }
+
+std::optional<Emulator::Fingerprint> Emulator::fingerprint() const
+{
+#ifdef TARGET_OS_LINUX
+    static constexpr std::string_view EXECUTABLE = "advmame";
+    static constexpr char PATH_SEPARATOR = ':';
+#elif defined(TARGET_OS_WINDOWS)
+    static constexpr std::string_view EXECUTABLE = "advmame.exe";
+    static constexpr char PATH_SEPARATOR = ';';
+#else
+#error "Unknown target OS. Compilation halted."
+#endif
+
+    // Same lookup the system does when launching the emulator
+    const auto* pathVariable = std::getenv("PATH");
+    std::string_view directories(pathVariable != nullptr ? pathVariable : "");
+    while (!directories.empty())
+    {
+        auto separator = std::min(directories.find(PATH_SEPARATOR), directories.size());
+        auto candidate = std::filesystem::path(directories.substr(0, separator)) / EXECUTABLE;
+        directories.remove_prefix(std::min(separator + 1, directories.size()));
+
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(candidate, ec))
+        {
+            continue;
+        }
+
+        auto size = std::filesystem::file_size(candidate, ec);
+        auto lastModified = std::filesystem::last_write_time(candidate, ec);
+        if (!ec)
+        {
+            return Fingerprint{.path = candidate.string(),
+                               .size = size,
+                               .lastModified = static_cast<std::int64_t>(lastModified.time_since_epoch().count())};
+        }
+    }
+
+    return std::nullopt;
+}
+
+Emulator::Fingerprint Emulator::fingerprintFromJson(const nlohmann::json& json)
+{
+    return Fingerprint{.path = json.at(FINGERPRINT_PATH_JSON_FIELD).get<std::string>(),
+                       .size = json.at(FINGERPRINT_SIZE_JSON_FIELD).get<std::uintmax_t>(),
+                       .lastModified = json.at(FINGERPRINT_LASTMODIFIED_JSON_FIELD).get<std::int64_t>()};
+}
+
+void Emulator::fingerprintToJson(nlohmann::json& json, const Fingerprint& fingerprint)
+{
+    json[FINGERPRINT_PATH_JSON_FIELD] = fingerprint.path;
+    json[FINGERPRINT_SIZE_JSON_FIELD] = fingerprint.size;
+    json[FINGERPRINT_LASTMODIFIED_JSON_FIELD] = fingerprint.lastModified;
+}
+
+std::future<std::optional<Emulator::EmulatorInfo>> Emulator::info(const std::filesystem::path& cacheFile) const
+{
+    const std::string cacheLog = fmt::format(R"(Emulator info cache operation on "{}".)", cacheFile.string());
+
+    auto binary = fingerprint();
+    if (!binary)
+    {
+        spdlog::warn("{} No emulator binary found", cacheLog);
+        std::promise<std::optional<EmulatorInfo>> result;
+        result.set_value(std::nullopt);
+        return result.get_future();
+    }
+
+    // Trusting the cache if it was written for this very binary
+    try
+    {
+        std::ifstream file(cacheFile);
+        auto json = nlohmann::json::parse(file);
+        if (fingerprintFromJson(json) == *binary)
+        {
+            spdlog::debug("{} Emulator did not change, using cached info", cacheLog);
+            std::promise<std::optional<EmulatorInfo>> result;
+            result.set_value(EmulatorInfo{.name = json.at(NAME_JSON_FIELD).get<std::string>(),
+                                          .version = json.at(VERSION_JSON_FIELD).get<std::string>()});
+            return result.get_future();
+        }
+
+        spdlog::debug(R"({} Emulator changed since info was cached, probing "{}" again)", cacheLog, binary->path);
+    }
+    catch (const nlohmann::json::exception& excep)
+    {
+        spdlog::debug(R"({} No usable cache, underlying json library threw "{}")", cacheLog, excep.what());
+    }
+
+    return std::async(std::launch::async, [this, cacheFile, cacheLog, binary = *binary]() {
+        auto result = info();
+        if (!result)
+        {
+            return result;
+        }
+
+        nlohmann::json json;
+        fingerprintToJson(json, binary);
+        json[NAME_JSON_FIELD] = result->name;
+        json[VERSION_JSON_FIELD] = result->version;
+
+        std::ofstream file(cacheFile);
+        file << json;
+        if (!file.good())
+        {
+            spdlog::warn("{} Could not write cache file", cacheLog);
+        }
+
+        return result;
+    });
+}
+
+ChefFun::Either<Emulator::Error, Emulator::Benchmark> Emulator::benchmark(const Rom::Game& rom,
+                                                                         std::uint32_t seconds) const
+{
+    using Result = ChefFun::Either<Error, Benchmark>;
+
+    auto cmdString = benchmarkArguments(rom, seconds);
+    if (cmdString.isLeft())
+    {
+        return Result::Left(cmdString.getLeft());
+    }
+
+    // A rom running slower than 1 / BENCHMARK_TIMEOUT_FACTOR of full speed is given up on, that leaves room for loading
+    const auto timeout = std::chrono::seconds(seconds) * BENCHMARK_TIMEOUT_FACTOR;
+    auto start = std::chrono::steady_clock::now();
+    auto result = launchHeadless(cmdString.getRight(), timeout);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (result.isLeft() || result.getRight().exitCode != 0)
+    {
+        return Result::Left(Emulator::Error::EMULATOR_ERROR);
+    }
+
+    auto speed = reportedSpeed(result.getRight().output);
+    if (!speed)
+    {
+        speed = seconds * 100.0 / std::max(elapsed.count(), 0.001);
+        spdlog::info("Emulator reported no speed, {:.2f}% computed from the {:.2f}s the run took", *speed,
+                     elapsed.count());
+    }
+
+    return Result::Right(Benchmark{.speed = *speed, .seconds = seconds});
+}
+
+Emulator::Benchmarks Emulator::benchmarks(const std::filesystem::path& cacheFile) const
+{
+    const std::string cacheLog = fmt::format(R"(Benchmark cache operation on "{}".)", cacheFile.string());
+
+    auto binary = fingerprint();
+    if (!binary)
+    {
+        spdlog::warn("{} No emulator binary found", cacheLog);
+        return {};
+    }
+
+    try
+    {
+        std::ifstream file(cacheFile);
+        auto json = nlohmann::json::parse(file);
+        if (fingerprintFromJson(json) != *binary)
+        {
+            spdlog::info("{} Emulator changed since the benchmarks were run, discarding them", cacheLog);
+            return {};
+        }
+
+        Benchmarks result;
+        for (const auto& [rom, benchmark] : json.at(BENCHMARKS_JSON_FIELD).items())
+        {
+            result.emplace(rom, Benchmark{.speed = benchmark.at(SPEED_JSON_FIELD).get<double>(),
+                                          .seconds = benchmark.at(SECONDS_JSON_FIELD).get<std::uint32_t>()});
+        }
+
+        return result;
+    }
+    catch (const nlohmann::json::exception& excep)
+    {
+        spdlog::debug(R"({} No usable cache, underlying json library threw "{}")", cacheLog, excep.what());
+    }
+
+    return {};
+}
+
+Emulator::Benchmarks Emulator::benchmark(const Rom::Library& library, const std::filesystem::path& cacheFile) const
+{
+    const std::string cacheLog = fmt::format(R"(Benchmark cache operation on "{}".)", cacheFile.string());
+
+    auto binary = fingerprint();
+    if (!binary)
+    {
+        spdlog::warn("{} No emulator binary found, nothing to benchmark", cacheLog);
+        return {};
+    }
+
+    auto result = benchmarks(cacheFile);
+    for (const auto& entry : library)
+    {
+        auto game = entry.game();
+        const std::string name(entry.stem());
+        if (!game.info().isLaunchable() || result.contains(name))
+        {
+            continue;
+        }
+
+        spdlog::info(R"(Benchmarking "{}" ({}))", game, name);
+        auto measure = benchmark(game);
+        if (measure.isLeft())
+        {
+            spdlog::warn(R"(Benchmarking "{}" failed: {})", game, magic_enum::enum_name(measure.getLeft()));
+            continue;
+        }
+
+        spdlog::info(R"(Benchmarking "{}" done: {:.2f}% of full speed)", game, measure.getRight().speed);
+        result.emplace(name, measure.getRight());
+
+        nlohmann::json json;
+        fingerprintToJson(json, *binary);
+        for (const auto& [rom, cached] : result)
+        {
+            json[BENCHMARKS_JSON_FIELD][rom] = {{SPEED_JSON_FIELD, cached.speed}, {SECONDS_JSON_FIELD, cached.seconds}};
+        }
+
+        std::ofstream file(cacheFile);
+        file << json;
+        if (!file.good())
+        {
+            spdlog::warn("{} Could not write cache file", cacheLog);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,263 @@
+#include "emulatortuner.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "utils.hpp"
+
+#ifdef TARGET_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace {
+// First line of every configuration Enea writes, what tells it apart from one written by hand
+constexpr std::string_view GENERATED_HEADER = "# Generated by Enea";
+
+constexpr std::uint64_t MEBIBYTE = 1024 * 1024;
+
+#ifdef TARGET_OS_LINUX
+std::optional<std::string> readFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return std::nullopt;
+    }
+
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Every mode of every display connected to a DRM card, modes files list them as "1920x1080" (or "1920x1080i")
+std::vector<EmulatorTuner::VideoMode> videoModes()
+{
+    std::vector<EmulatorTuner::VideoMode> result;
+
+    std::error_code ec;
+    for (const auto& connector : std::filesystem::directory_iterator("/sys/class/drm", ec))
+    {
+        auto status = readFile(connector.path() / "status");
+        if (!status || !status->starts_with("connected"))
+        {
+            continue;
+        }
+
+        std::ifstream modes(connector.path() / "modes");
+        for (std::string mode; std::getline(modes, mode);)
+        {
+            unsigned int width = 0;
+            unsigned int height = 0;
+            if (std::sscanf(mode.c_str(), "%ux%u", &width, &height) == 2)
+            {
+                result.push_back(EmulatorTuner::VideoMode{.width = width, .height = height});
+            }
+        }
+    }
+
+    std::ranges::sort(result);
+    auto [first, last] = std::ranges::unique(result);
+    result.erase(first, last);
+    return result;
+}
+#endif
+} // namespace
+
+EmulatorTuner::Hardware EmulatorTuner::hardware() const
+{
+    Hardware result{.cores = std::max(std::thread::hardware_concurrency(), 1U)};
+
+#ifdef TARGET_OS_LINUX
+    if (auto pages = sysconf(_SC_PHYS_PAGES), pageSize = sysconf(_SC_PAGE_SIZE); pages > 0 && pageSize > 0)
+    {
+        result.memory = static_cast<std::uint64_t>(pages) * static_cast<std::uint64_t>(pageSize);
+    }
+
+    // The device tree model is null terminated
+    if (auto model = readFile("/proc/device-tree/model"); model)
+    {
+        result.model = model->substr(0, model->find('\0'));
+    }
+
+    result.videoModes = videoModes();
+#elif defined(TARGET_OS_WINDOWS)
+    // Only cores are probed on Windows, the rest is left to advmame defaults
+#else
+#error "Unknown target OS. Compilation halted."
+#endif
+
+    return result;
+}
+
+EmulatorTuner::Calibration EmulatorTuner::calibrate() const
+{
+    static constexpr std::uint32_t ITERATIONS = 50'000'000;
+    static constexpr int SLEEPS = 20;
+
+    // A linear congruential generator: every iteration depends on the previous one, so it can't be vectorized away
+    auto start = std::chrono::steady_clock::now();
+    volatile std::uint32_t seed = 1;
+    std::uint32_t state = seed;
+    for (std::uint32_t i = 0; i < ITERATIONS; i++)
+    {
+        state = state * 1664525U + 1013904223U;
+    }
+    seed = state;
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::chrono::microseconds jitter{0};
+    for (int i = 0; i < SLEEPS; i++)
+    {
+        auto sleepStart = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        auto slept = std::chrono::steady_clock::now() - sleepStart;
+        jitter = std::max(jitter, std::chrono::duration_cast<std::chrono::microseconds>(
+                                      slept - std::chrono::milliseconds(1)));
+    }
+
+    return Calibration{.coreSpeed = ITERATIONS / 1'000'000.0 / std::max(elapsed.count(), 0.001),
+                       .timerJitter = jitter};
+}
+
+std::string EmulatorTuner::configuration(const Hardware& hardware, const Calibration& calibration)
+{
+    const bool slow = calibration.coreSpeed < SLOW_CORE_SPEED;
+    const bool fast = calibration.coreSpeed >= FAST_CORE_SPEED;
+    const bool preciseTimer = calibration.timerJitter < std::chrono::microseconds(500);
+    const bool lowMemory = hardware.memory && *hardware.memory < 512 * MEBIBYTE;
+
+    // Integer scaling looks best but leaves big borders on small displays, 4x a 240 lines game needs 960 lines
+    auto biggest = std::ranges::max_element(hardware.videoModes, {}, &VideoMode::height);
+    const bool bigDisplay = biggest != hardware.videoModes.end() && biggest->height >= 960;
+
+    // A sloppy timer needs a deeper audio buffer to avoid underruns, a fast machine can afford a shallow one
+    double latency = 0.05;
+    if (slow || calibration.timerJitter > std::chrono::milliseconds(2))
+    {
+        latency = 0.1;
+    }
+    else if (fast && preciseTimer)
+    {
+        latency = 0.03;
+    }
+
+    std::string result = fmt::format("{} for {}, {} cores, {}, core speed {:.0f}, timer jitter {}us\n",
+                                     GENERATED_HEADER, hardware.model.value_or("an unknown board"), hardware.cores,
+                                     hardware.memory ? fmt::format("{} MiB", *hardware.memory / MEBIBYTE)
+                                                     : std::string("unknown memory"),
+                                     calibration.coreSpeed, calibration.timerJitter.count());
+    result += "# Remove the first line to keep Enea from generating this file again\n";
+
+    auto option = [&result](std::string_view name, std::string_view value) {
+        result += fmt::format("{} {}\n", name, value);
+    };
+
+    option("misc_smp", hardware.cores > 1 ? "yes" : "no");
+    option("display_mode", "auto");
+    option("display_resize", bigDisplay ? "integer" : "mixed");
+    option("display_resizeeffect", slow ? "none" : "auto");
+    option("display_vsync", slow ? "no" : "yes");
+    option("display_frameskip", slow ? "auto" : "1.0");
+    option("sync_resample", "auto");
+    option("sound_samplerate", slow || lowMemory ? "22050" : "44100");
+    option("sound_latency", fmt::format("{:.2f}", latency));
+
+    return result;
+}
+
+nlohmann::json EmulatorTuner::hardwareToJson(const Hardware& hardware)
+{
+    nlohmann::json json;
+    json[CORES_JSON_FIELD] = hardware.cores;
+    utils::addOptionalToJson(json, MEMORY_JSON_FIELD, hardware.memory);
+    utils::addOptionalToJson(json, MODEL_JSON_FIELD, hardware.model);
+    json[VIDEOMODES_JSON_FIELD] = nlohmann::json::array();
+    for (const auto& mode : hardware.videoModes)
+    {
+        json[VIDEOMODES_JSON_FIELD].push_back({{WIDTH_JSON_FIELD, mode.width}, {HEIGHT_JSON_FIELD, mode.height}});
+    }
+
+    return json;
+}
+
+EmulatorTuner::Hardware EmulatorTuner::hardwareFromJson(const nlohmann::json& json)
+{
+    Hardware result{.cores = json.at(CORES_JSON_FIELD).get<unsigned int>(),
+                    .memory = utils::getOptionalValueFromJson<std::uint64_t>(json, MEMORY_JSON_FIELD),
+                    .model = utils::getOptionalValueFromJson<std::string>(json, MODEL_JSON_FIELD)};
+    for (const auto& mode : json.at(VIDEOMODES_JSON_FIELD))
+    {
+        result.videoModes.push_back(VideoMode{.width = mode.at(WIDTH_JSON_FIELD).get<unsigned int>(),
+                                              .height = mode.at(HEIGHT_JSON_FIELD).get<unsigned int>()});
+    }
+
+    return result;
+}
+
+bool EmulatorTuner::tune(const std::filesystem::path& configurationFile, const std::filesystem::path& cacheFile) const
+{
+    const std::string tuneLog = fmt::format(R"(Emulator tuning operation on "{}".)", configurationFile.string());
+
+    // Never overwriting a configuration somebody wrote by hand
+    bool configurationExists = false;
+    if (std::ifstream existing(configurationFile); existing.is_open())
+    {
+        std::string header;
+        std::getline(existing, header);
+        if (!header.starts_with(GENERATED_HEADER))
+        {
+            spdlog::info("{} Configuration was not generated by Enea, leaving it as it is", tuneLog);
+            return false;
+        }
+
+        configurationExists = true;
+    }
+    else if (std::error_code ec; !std::filesystem::remove(cacheFile, ec) && ec)
+    {
+        // Not trusted anyway without a configuration, it must not keep Enea from starting
+        spdlog::debug(R"({} Could not remove cache file: "{}")", tuneLog, ec.message());
+    }
+
+    auto current = hardware();
+    try
+    {
+        std::ifstream file(cacheFile);
+        if (configurationExists && hardwareFromJson(nlohmann::json::parse(file)) == current)
+        {
+            spdlog::debug("{} Hardware did not change, configuration is up to date", tuneLog);
+            return false;
+        }
+    }
+    catch (const nlohmann::json::exception& excep)
+    {
+        spdlog::debug(R"({} No usable cache, underlying json library threw "{}")", tuneLog, excep.what());
+    }
+
+    spdlog::info(R"({} Hardware changed, calibrating on "{}" with {} cores)", tuneLog,
+                 current.model.value_or("an unknown board"), current.cores);
+    auto calibration = calibrate();
+
+    std::error_code ec;
+    std::filesystem::create_directories(configurationFile.parent_path(), ec);
+    std::ofstream configuration(configurationFile);
+    configuration << EmulatorTuner::configuration(current, calibration);
+    if (!configuration.good())
+    {
+        spdlog::warn("{} Could not write configuration file", tuneLog);
+        return false;
+    }
+
+    std::ofstream cache(cacheFile);
+    cache << hardwareToJson(current);
+    if (!cache.good())
+    {
+        spdlog::warn("{} Could not write cache file", tuneLog);
+    }
+
+    spdlog::info("{} Configuration generated, core speed {:.0f}, timer jitter {}us", tuneLog, calibration.coreSpeed,
+                 calibration.timerJitter.count());
+    return true;
+}
@@ -0,0 +1,387 @@
+#include "launcher.hpp"
+
+#include <spdlog/spdlog.h>
+
+#ifdef TARGET_OS_LINUX
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string_view>
+
+#include <fcntl.h>
+#include <nlohmann/json.hpp>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "utils.hpp"
+#endif
+
+namespace {
+#ifdef TARGET_OS_LINUX
+// A request is a single packet, way bigger than any command line and environment we build
+constexpr std::size_t MAX_MESSAGE = 64 * 1024;
+// Every answer carries the output and the status descriptors of the command
+constexpr std::size_t ANSWER_DESCRIPTORS = 2;
+
+constexpr std::string_view ARGUMENTS_JSON_FIELD = "arguments";
+constexpr std::string_view ENVIRONMENT_JSON_FIELD = "environment";
+constexpr std::string_view PID_JSON_FIELD = "pid";
+constexpr std::string_view ERROR_JSON_FIELD = "error";
+
+void closeAll(const std::vector<int>& descriptors)
+{
+    for (auto descriptor : descriptors)
+    {
+        close(descriptor);
+    }
+}
+
+bool sendMessage(int socket, const std::string& message, const std::vector<int>& descriptors = {})
+{
+    iovec data{.iov_base = const_cast<char*>(message.data()), .iov_len = message.size()}; // NOLINT
+    std::array<char, CMSG_SPACE(ANSWER_DESCRIPTORS * sizeof(int))> control{};
+
+    msghdr header{};
+    header.msg_iov = &data;
+    header.msg_iovlen = 1;
+    if (!descriptors.empty())
+    {
+        header.msg_control = control.data();
+        header.msg_controllen = CMSG_SPACE(descriptors.size() * sizeof(int));
+        auto* descriptorsHeader = CMSG_FIRSTHDR(&header);
+        descriptorsHeader->cmsg_level = SOL_SOCKET;
+        descriptorsHeader->cmsg_type = SCM_RIGHTS;
+        descriptorsHeader->cmsg_len = CMSG_LEN(descriptors.size() * sizeof(int));
+        std::memcpy(CMSG_DATA(descriptorsHeader), descriptors.data(), descriptors.size() * sizeof(int));
+    }
+
+    ssize_t sent = 0;
+    do
+    {
+        sent = sendmsg(socket, &header, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+
+    return sent == static_cast<ssize_t>(message.size());
+}
+
+// Nothing is returned once the other side is gone. Descriptors sent along are stored in descriptors
+std::optional<std::string> receiveMessage(int socket, std::vector<int>& descriptors)
+{
+    std::string message(MAX_MESSAGE, '\0');
+    iovec data{.iov_base = message.data(), .iov_len = message.size()};
+    std::array<char, CMSG_SPACE(ANSWER_DESCRIPTORS * sizeof(int))> control{};
+
+    msghdr header{};
+    header.msg_iov = &data;
+    header.msg_iovlen = 1;
+    header.msg_control = control.data();
+    header.msg_controllen = control.size();
+
+    ssize_t received = 0;
+    do
+    {
+        received = recvmsg(socket, &header, MSG_CMSG_CLOEXEC);
+    } while (received < 0 && errno == EINTR);
+
+    for (auto* descriptorsHeader = CMSG_FIRSTHDR(&header); descriptorsHeader != nullptr;
+         descriptorsHeader = CMSG_NXTHDR(&header, descriptorsHeader))
+    {
+        if (descriptorsHeader->cmsg_level == SOL_SOCKET && descriptorsHeader->cmsg_type == SCM_RIGHTS)
+        {
+            const auto count = (descriptorsHeader->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            const auto first = descriptors.size();
+            descriptors.resize(first + count);
+            std::memcpy(descriptors.data() + first, CMSG_DATA(descriptorsHeader), count * sizeof(int));
+        }
+    }
+
+    // Every message is a json object, an empty one means the socket was closed
+    if (received <= 0)
+    {
+        closeAll(descriptors);
+        descriptors.clear();
+        return std::nullopt;
+    }
+
+    message.resize(static_cast<std::size_t>(received));
+    return message;
+}
+
+// Spawns a command from the calling process, its output goes to a pipe. No status descriptor is involved: the command
+// is a child of the caller, which waits for it
+ChefFun::Either<int, Launcher::Child> spawnHere(const std::vector<std::string>& arguments,
+                                                const std::vector<std::string>& environment)
+{
+    using Result = ChefFun::Either<int, Launcher::Child>;
+
+    if (arguments.empty())
+    {
+        return Result::Left(EINVAL);
+    }
+
+    std::array<int, 2> outputPipe{};
+    if (pipe2(outputPipe.data(), O_CLOEXEC) != 0)
+    {
+        return Result::Left(errno);
+    }
+
+    std::vector<char*> argv;
+    argv.reserve(arguments.size() + 1);
+    for (const auto& argument : arguments)
+    {
+        argv.push_back(const_cast<char*>(argument.c_str())); // NOLINT
+    }
+    argv.push_back(nullptr);
+
+    std::vector<char*> envp;
+    envp.reserve(environment.size() + 1);
+    for (const auto& variable : environment)
+    {
+        envp.push_back(const_cast<char*>(variable.c_str())); // NOLINT
+    }
+    envp.push_back(nullptr);
+
+    // Output goes to our pipe, everything else is inherited. The pipe itself is closed on exec
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, outputPipe[1], STDOUT_FILENO);
+
+    // The command gets its own process group so we can signal it together with anything it spawns,
+    // it also should not inherit signals blocked by the thread launching it (nor a SIGPIPE the helper ignores)
+    sigset_t noSignals;
+    sigemptyset(&noSignals);
+    sigset_t defaultSignals;
+    sigemptyset(&defaultSignals);
+    sigaddset(&defaultSignals, SIGPIPE);
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+    short flags = POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+#ifdef POSIX_SPAWN_USEVFORK
+    // Never copy the page tables of the caller just to exec something else. Recent glibc always does this
+    flags |= POSIX_SPAWN_USEVFORK;
+#endif
+    posix_spawnattr_setflags(&attributes, flags);
+    posix_spawnattr_setpgroup(&attributes, 0);
+    posix_spawnattr_setsigmask(&attributes, &noSignals);
+    posix_spawnattr_setsigdefault(&attributes, &defaultSignals);
+
+    pid_t pid = 0;
+    auto result = posix_spawnp(&pid, argv[0], &actions, &attributes, argv.data(), envp.data());
+    posix_spawnattr_destroy(&attributes);
+    posix_spawn_file_actions_destroy(&actions);
+    close(outputPipe[1]);
+
+    if (result != 0)
+    {
+        close(outputPipe[0]);
+        return Result::Left(result);
+    }
+
+    return Result::Right(Launcher::Child{.pid = pid, .outputFd = outputPipe[0], .statusFd = -1});
+}
+
+// Runs in the helper: spawns a command as asked and answers with its pid and descriptors, or with the error
+void answer(int socket, const std::string& request, std::map<pid_t, int>& running)
+{
+    nlohmann::json result;
+    auto json = nlohmann::json::parse(request, nullptr, false);
+    auto arguments = json.is_discarded() ? std::nullopt
+                                         : utils::getOptionalValueFromJson<std::vector<std::string>>(
+                                               json, ARGUMENTS_JSON_FIELD);
+    auto environment = json.is_discarded() ? std::nullopt
+                                           : utils::getOptionalValueFromJson<std::vector<std::string>>(
+                                                 json, ENVIRONMENT_JSON_FIELD);
+
+    std::array<int, 2> statusPipe{};
+    if (!arguments || !environment)
+    {
+        result[ERROR_JSON_FIELD] = EINVAL;
+    }
+    else if (pipe2(statusPipe.data(), O_CLOEXEC) != 0)
+    {
+        result[ERROR_JSON_FIELD] = errno;
+    }
+    else if (auto child = spawnHere(*arguments, *environment); child.isLeft())
+    {
+        closeAll({statusPipe[0], statusPipe[1]});
+        result[ERROR_JSON_FIELD] = child.getLeft();
+    }
+    else
+    {
+        // The write end stays here until the command exits, the rest belongs to Enea
+        const auto& spawned = child.getRight();
+        running[spawned.pid] = statusPipe[1];
+        result[PID_JSON_FIELD] = spawned.pid;
+        std::ignore = sendMessage(socket, result.dump(), {spawned.outputFd, statusPipe[0]});
+        closeAll({spawned.outputFd, statusPipe[0]});
+        return;
+    }
+
+    std::ignore = sendMessage(socket, result.dump());
+}
+
+// Runs in the helper: reports the wait status of every command which exited
+void reapExited(std::map<pid_t, int>& running)
+{
+    int status = 0;
+    pid_t pid = 0;
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0)
+    {
+        if (auto found = running.find(pid); found != running.end())
+        {
+            std::ignore = write(found->second, &status, sizeof(status));
+            close(found->second);
+            running.erase(found);
+        }
+    }
+}
+
+// The helper itself: it serves requests until Enea goes away, commands still running are left alone
+[[noreturn]] void serve(int socket)
+{
+    // Exits are noticed through a descriptor, so a single poll() waits for both requests and exits
+    sigset_t childSignals;
+    sigemptyset(&childSignals);
+    sigaddset(&childSignals, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &childSignals, nullptr);
+    const int exits = signalfd(-1, &childSignals, SFD_CLOEXEC | SFD_NONBLOCK);
+    // Enea may stop listening for the status of a command (eg: it dropped it), that must not kill us
+    signal(SIGPIPE, SIG_IGN);
+
+    std::map<pid_t, int> running;
+    std::array<pollfd, 2> descriptors{pollfd{.fd = socket, .events = POLLIN, .revents = 0},
+                                      pollfd{.fd = exits, .events = POLLIN, .revents = 0}};
+    while (true)
+    {
+        if (poll(descriptors.data(), descriptors.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        if (descriptors[1].revents != 0)
+        {
+            signalfd_siginfo signal{};
+            while (read(exits, &signal, sizeof(signal)) > 0)
+            {
+            }
+
+            reapExited(running);
+        }
+
+        if (descriptors[0].revents != 0)
+        {
+            std::vector<int> ignored;
+            auto request = receiveMessage(socket, ignored);
+            closeAll(ignored);
+            if (!request)
+            {
+                break;
+            }
+
+            answer(socket, *request, running);
+        }
+    }
+
+    _exit(0);
+}
+#endif
+} // namespace
+
+bool Launcher::start()
+{
+#ifdef TARGET_OS_LINUX
+    std::scoped_lock lock(mMutex);
+    if (mSocket >= 0)
+    {
+        return true;
+    }
+
+    std::array<int, 2> sockets{};
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets.data()) != 0)
+    {
+        spdlog::warn(R"(Launcher helper could not be started, could not create its socket: "{}")",
+                     std::strerror(errno));
+        return false;
+    }
+
+    auto pid = fork();
+    if (pid < 0)
+    {
+        spdlog::warn(R"(Launcher helper could not be started, could not fork: "{}")", std::strerror(errno));
+        closeAll({sockets[0], sockets[1]});
+        return false;
+    }
+
+    if (pid == 0)
+    {
+        close(sockets[0]);
+        serve(sockets[1]);
+    }
+
+    close(sockets[1]);
+    mSocket = sockets[0];
+    spdlog::debug("Launcher helper started with pid {}", pid);
+    return true;
+#else
+    spdlog::debug("Launcher helper is not supported on this platform, commands are spawned by Enea itself");
+    return false;
+#endif
+}
+
+bool Launcher::running()
+{
+    std::scoped_lock lock(mMutex);
+    return mSocket >= 0;
+}
+
+#ifdef TARGET_OS_LINUX
+ChefFun::Either<int, Launcher::Child> Launcher::spawn(const std::vector<std::string>& arguments,
+                                                      const std::vector<std::string>& environment)
+{
+    using Result = ChefFun::Either<int, Child>;
+
+    nlohmann::json request;
+    request[ARGUMENTS_JSON_FIELD] = arguments;
+    request[ENVIRONMENT_JSON_FIELD] = environment;
+    const auto message = request.dump();
+
+    std::scoped_lock lock(mMutex);
+    if (mSocket < 0 || message.size() > MAX_MESSAGE)
+    {
+        return spawnHere(arguments, environment);
+    }
+
+    std::vector<int> descriptors;
+    auto answer = sendMessage(mSocket, message) ? receiveMessage(mSocket, descriptors) : std::nullopt;
+    if (!answer)
+    {
+        spdlog::error("Launcher helper is gone, commands are spawned by Enea itself from now on");
+        close(mSocket);
+        mSocket = -1;
+        return spawnHere(arguments, environment);
+    }
+
+    auto json = nlohmann::json::parse(*answer, nullptr, false);
+    auto pid = json.is_discarded() ? std::nullopt : utils::getOptionalValueFromJson<pid_t>(json, PID_JSON_FIELD);
+    if (!pid || descriptors.size() != ANSWER_DESCRIPTORS)
+    {
+        closeAll(descriptors);
+        auto error = json.is_discarded() ? std::nullopt : utils::getOptionalValueFromJson<int>(json, ERROR_JSON_FIELD);
+        return Result::Left(error.value_or(EPROTO));
+    }
+
+    return Result::Right(Child{.pid = *pid, .outputFd = descriptors[0], .statusFd = descriptors[1]});
+}
+#endif
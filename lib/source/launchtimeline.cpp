@@ -0,0 +1,132 @@
+#include "launchtimeline.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace {
+std::size_t bucket(std::chrono::microseconds duration)
+{
+    auto microseconds = static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0));
+    return std::min<std::size_t>(std::bit_width(microseconds), LaunchTimeline::BUCKETS - 1);
+}
+} // namespace
+
+void LaunchTimeline::mark(Phase phase, Clock::time_point when)
+{
+    mMarks[magic_enum::enum_integer(phase)] = when;
+}
+
+void LaunchTimeline::reset()
+{
+    mMarks.fill(std::nullopt);
+}
+
+std::optional<LaunchTimeline::Clock::duration> LaunchTimeline::duration(Phase phase) const
+{
+    auto index = static_cast<std::size_t>(magic_enum::enum_integer(phase));
+    if (!mMarks[index])
+    {
+        return std::nullopt;
+    }
+
+    if (index == 0)
+    {
+        return Clock::duration::zero();
+    }
+
+    if (!mMarks[index - 1])
+    {
+        return std::nullopt;
+    }
+
+    return *mMarks[index] - *mMarks[index - 1];
+}
+
+bool LaunchTimeline::complete() const
+{
+    return std::ranges::all_of(mMarks, [](const auto& mark) { return mark.has_value(); });
+}
+
+std::string LaunchTimeline::summary() const
+{
+    std::string result;
+    for (auto phase : magic_enum::enum_values<Phase>())
+    {
+        if (auto took = duration(phase); took)
+        {
+            std::chrono::duration<double, std::milli> milliseconds = *took;
+            result += fmt::format("{}{} +{:.2f}ms", result.empty() ? "" : ", ", magic_enum::enum_name(phase),
+                                  milliseconds.count());
+        }
+    }
+
+    return result;
+}
+
+bool LaunchTimeline::record(const std::filesystem::path& histogramFile, std::string_view version) const
+{
+    const std::string recordLog = fmt::format(R"(Launch histogram write operation on "{}".)", histogramFile.string());
+
+    nlohmann::json json = nlohmann::json::object();
+    try
+    {
+        std::ifstream file(histogramFile);
+        if (file.is_open())
+        {
+            json = nlohmann::json::parse(file);
+        }
+    }
+    catch (const nlohmann::json::exception& excep)
+    {
+        spdlog::warn(R"({} Unreadable histograms are started over. Underlying json library threw "{}")", recordLog,
+                     excep.what());
+    }
+
+    try
+    {
+        auto& histograms = json[version];
+        for (auto phase : magic_enum::enum_values<Phase>())
+        {
+            auto took = duration(phase);
+            if (!took)
+            {
+                continue;
+            }
+
+            auto& histogram = histograms[magic_enum::enum_name(phase)];
+            if (!histogram.contains(BUCKETS_JSON_FIELD))
+            {
+                histogram[COUNT_JSON_FIELD] = 0;
+                histogram[TOTAL_JSON_FIELD] = 0;
+                histogram[BUCKETS_JSON_FIELD] = std::vector<std::uint64_t>(BUCKETS, 0);
+            }
+
+            auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(*took);
+            histogram[COUNT_JSON_FIELD] = histogram[COUNT_JSON_FIELD].get<std::uint64_t>() + 1;
+            histogram[TOTAL_JSON_FIELD] = histogram[TOTAL_JSON_FIELD].get<std::int64_t>() + microseconds.count();
+            auto& count = histogram[BUCKETS_JSON_FIELD].at(bucket(microseconds));
+            count = count.get<std::uint64_t>() + 1;
+        }
+    }
+    catch (const nlohmann::json::exception& excep)
+    {
+        spdlog::warn(R"({} Existing histograms are malformed. Underlying json library threw "{}")", recordLog,
+                     excep.what());
+        return false;
+    }
+
+    std::ofstream file(histogramFile);
+    file << json;
+    if (!file.good())
+    {
+        spdlog::warn("{} Could not write histogram file", recordLog);
+        return false;
+    }
+
+    return true;
+}
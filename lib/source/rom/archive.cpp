@@ -0,0 +1,329 @@
+#include "rom/archive.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+#ifdef TARGET_OS_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+// Zip format constants, as described by the PKWARE APPNOTE
+constexpr std::uint32_t END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054b50;
+constexpr std::uint32_t ZIP64_END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06064b50;
+constexpr std::uint32_t ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+constexpr std::uint32_t CENTRAL_DIRECTORY_SIGNATURE = 0x02014b50;
+constexpr std::uint16_t ZIP64_EXTRA_FIELD_ID = 0x0001;
+
+constexpr std::uint64_t END_OF_CENTRAL_DIRECTORY_SIZE = 22;
+constexpr std::uint64_t ZIP64_END_OF_CENTRAL_DIRECTORY_SIZE = 56;
+constexpr std::uint64_t ZIP64_LOCATOR_SIZE = 20;
+constexpr std::uint64_t CENTRAL_DIRECTORY_HEADER_SIZE = 46;
+constexpr std::uint64_t MAX_COMMENT_SIZE = std::numeric_limits<std::uint16_t>::max();
+
+struct CentralDirectory
+{
+    std::uint64_t offset;
+    std::uint64_t size;
+    std::uint64_t entries;
+};
+
+template <typename T> [[nodiscard]] T readLittleEndian(std::span<const std::byte> data, std::size_t offset)
+{
+    T result = 0;
+    for (std::size_t i = 0; i < sizeof(T); i++)
+    {
+        result |= static_cast<T>(static_cast<T>(data[offset + i]) << (8 * i));
+    }
+
+    return result;
+}
+
+[[nodiscard]] std::string lowercase(std::string_view string)
+{
+    std::string result(string);
+    std::ranges::transform(result, result.begin(), [](unsigned char c) { return std::tolower(c); });
+    return result;
+}
+
+[[nodiscard]] std::optional<CentralDirectory> zip64CentralDirectory(std::uint64_t locatorOffset,
+                                                                    const auto& reader)
+{
+    auto locator = reader(locatorOffset, ZIP64_LOCATOR_SIZE);
+    if (!locator || readLittleEndian<std::uint32_t>(*locator, 0) != ZIP64_LOCATOR_SIGNATURE)
+    {
+        return std::nullopt;
+    }
+
+    auto record = reader(readLittleEndian<std::uint64_t>(*locator, 8), ZIP64_END_OF_CENTRAL_DIRECTORY_SIZE);
+    if (!record || readLittleEndian<std::uint32_t>(*record, 0) != ZIP64_END_OF_CENTRAL_DIRECTORY_SIGNATURE)
+    {
+        return std::nullopt;
+    }
+
+    return CentralDirectory{.offset = readLittleEndian<std::uint64_t>(*record, 48),
+                            .size = readLittleEndian<std::uint64_t>(*record, 40),
+                            .entries = readLittleEndian<std::uint64_t>(*record, 32)};
+}
+
+[[nodiscard]] std::optional<CentralDirectory> findCentralDirectory(std::uint64_t archiveSize, const auto& reader)
+{
+    if (archiveSize < END_OF_CENTRAL_DIRECTORY_SIZE)
+    {
+        return std::nullopt;
+    }
+
+    // The end of central directory record sits at the very end of the archive, only followed by an optional comment
+    const std::uint64_t tailSize = std::min(archiveSize, END_OF_CENTRAL_DIRECTORY_SIZE + MAX_COMMENT_SIZE);
+    const std::uint64_t tailOffset = archiveSize - tailSize;
+    auto tail = reader(tailOffset, tailSize);
+    if (!tail)
+    {
+        return std::nullopt;
+    }
+
+    for (auto pos = static_cast<std::int64_t>(tailSize - END_OF_CENTRAL_DIRECTORY_SIZE); pos >= 0; pos--)
+    {
+        auto position = static_cast<std::size_t>(pos);
+        if (readLittleEndian<std::uint32_t>(*tail, position) != END_OF_CENTRAL_DIRECTORY_SIGNATURE)
+        {
+            continue;
+        }
+
+        CentralDirectory result{.offset = readLittleEndian<std::uint32_t>(*tail, position + 16),
+                                .size = readLittleEndian<std::uint32_t>(*tail, position + 12),
+                                .entries = readLittleEndian<std::uint16_t>(*tail, position + 10)};
+
+        // Saturated fields mean the real values are stored in the zip64 record
+        if (result.offset == std::numeric_limits<std::uint32_t>::max() ||
+            result.size == std::numeric_limits<std::uint32_t>::max() ||
+            result.entries == std::numeric_limits<std::uint16_t>::max())
+        {
+            const std::uint64_t eocdOffset = tailOffset + position;
+            if (eocdOffset < ZIP64_LOCATOR_SIZE)
+            {
+                return std::nullopt;
+            }
+
+            return zip64CentralDirectory(eocdOffset - ZIP64_LOCATOR_SIZE, reader);
+        }
+
+        return result;
+    }
+
+    return std::nullopt;
+}
+
+[[nodiscard]] std::optional<std::vector<Rom::File>> parseCentralDirectory(std::span<const std::byte> directory,
+                                                                          std::uint64_t entries)
+{
+    std::vector<Rom::File> result;
+    result.reserve(std::min<std::uint64_t>(entries, directory.size() / CENTRAL_DIRECTORY_HEADER_SIZE));
+
+    std::size_t position = 0;
+    for (std::uint64_t entry = 0; entry < entries; entry++)
+    {
+        if (directory.size() - position < CENTRAL_DIRECTORY_HEADER_SIZE ||
+            readLittleEndian<std::uint32_t>(directory, position) != CENTRAL_DIRECTORY_SIGNATURE)
+        {
+            return std::nullopt;
+        }
+
+        const auto crc = readLittleEndian<std::uint32_t>(directory, position + 16);
+        std::uint64_t size = readLittleEndian<std::uint32_t>(directory, position + 24);
+        const auto nameLength = readLittleEndian<std::uint16_t>(directory, position + 28);
+        const auto extraLength = readLittleEndian<std::uint16_t>(directory, position + 30);
+        const auto commentLength = readLittleEndian<std::uint16_t>(directory, position + 32);
+
+        const std::size_t nameOffset = position + CENTRAL_DIRECTORY_HEADER_SIZE;
+        const std::size_t extraOffset = nameOffset + nameLength;
+        const std::size_t next = extraOffset + extraLength + commentLength;
+        if (next > directory.size())
+        {
+            return std::nullopt;
+        }
+
+        // Big members store their real uncompressed size in the zip64 extra field
+        if (size == std::numeric_limits<std::uint32_t>::max())
+        {
+            for (std::size_t field = extraOffset; field + 4 <= extraOffset + extraLength;)
+            {
+                const auto fieldId = readLittleEndian<std::uint16_t>(directory, field);
+                const auto fieldSize = readLittleEndian<std::uint16_t>(directory, field + 2);
+                if (fieldId == ZIP64_EXTRA_FIELD_ID && fieldSize >= sizeof(std::uint64_t) &&
+                    field + 4 + sizeof(std::uint64_t) <= extraOffset + extraLength)
+                {
+                    size = readLittleEndian<std::uint64_t>(directory, field + 4);
+                    break;
+                }
+
+                field += 4 + fieldSize;
+            }
+        }
+
+        std::string name(reinterpret_cast<const char*>(directory.data() + nameOffset), nameLength);
+
+        // Folders are just names in a zip, they carry no data
+        if (!name.empty() && name.back() != '/')
+        {
+            result.push_back(Rom::File{.name = std::move(name), .size = size, .crc = crc});
+        }
+
+        position = next;
+    }
+
+    return result;
+}
+} // namespace
+
+Rom::Archive::Result Rom::Archive::members(std::uint64_t archiveSize, const Reader& reader)
+{
+    auto centralDirectory = findCentralDirectory(archiveSize, reader);
+    if (!centralDirectory)
+    {
+        return Result::Left(Error::NO_END_OF_CENTRAL_DIRECTORY);
+    }
+
+    auto directory = reader(centralDirectory->offset, centralDirectory->size);
+    if (!directory)
+    {
+        return Result::Left(Error::MALFORMED_CENTRAL_DIRECTORY);
+    }
+
+    auto files = parseCentralDirectory(*directory, centralDirectory->entries);
+    if (!files)
+    {
+        return Result::Left(Error::MALFORMED_CENTRAL_DIRECTORY);
+    }
+
+    return Result::Right(*files);
+}
+
+Rom::Archive::Result Rom::Archive::members(std::span<const std::byte> archive)
+{
+    return members(archive.size(),
+                   [&archive](std::uint64_t offset, std::uint64_t size) -> std::optional<std::span<const std::byte>> {
+                       if (offset > archive.size() || size > archive.size() - offset)
+                       {
+                           return std::nullopt;
+                       }
+
+                       return archive.subspan(offset, size);
+                   });
+}
+
+Rom::Archive::Result Rom::Archive::members(const std::filesystem::path& path)
+{
+#ifdef TARGET_OS_LINUX
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return Result::Left(Error::OPEN_FILE);
+    }
+
+    struct stat info = {};
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return Result::Left(Error::OPEN_FILE);
+    }
+
+    const auto size = static_cast<std::size_t>(info.st_size);
+    if (size == 0)
+    {
+        close(fd);
+        return Result::Left(Error::NO_END_OF_CENTRAL_DIRECTORY);
+    }
+
+    // Mapping the whole file is just address space: only the pages we actually touch (the tail of the archive)
+    // will ever be read from disk
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        return Result::Left(Error::MEMORY_MAP);
+    }
+
+    madvise(mapped, size, MADV_RANDOM);
+    auto result = members(std::span<const std::byte>(static_cast<const std::byte*>(mapped), size));
+    munmap(mapped, size);
+
+    return result;
+#elif defined(TARGET_OS_WINDOWS)
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return Result::Left(Error::OPEN_FILE);
+    }
+
+    const auto size = static_cast<std::uint64_t>(file.tellg());
+    std::vector<std::vector<std::byte>> buffers;
+    return members(size, [&file, &buffers, size](std::uint64_t offset,
+                                                 std::uint64_t length) -> std::optional<std::span<const std::byte>> {
+        if (offset > size || length > size - offset)
+        {
+            return std::nullopt;
+        }
+
+        auto& buffer = buffers.emplace_back(length);
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(length));
+        if (!file)
+        {
+            return std::nullopt;
+        }
+
+        return std::span<const std::byte>(buffer);
+    });
+#else
+#error "Unknown target OS. Compilation halted."
+#endif
+}
+
+Rom::Audit Rom::Archive::audit(const std::vector<Rom::File>& members, const std::vector<Rom::File>& expected)
+{
+    std::unordered_map<std::string, const Rom::File*> byName;
+    byName.reserve(members.size());
+    for (const auto& member : members)
+    {
+        byName.try_emplace(lowercase(member.name), &member);
+    }
+
+    auto result = Audit::GOOD;
+    for (const auto& file : expected)
+    {
+        const Rom::File* member = nullptr;
+        if (auto found = byName.find(lowercase(file.name)); found != byName.end())
+        {
+            member = found->second;
+        }
+        // MAME looks for dumps by crc too, so a renamed file is still fine
+        else if (auto byCrc = std::ranges::find_if(members,
+                                                   [&file](const Rom::File& candidate) {
+                                                       return candidate.crc == file.crc && candidate.size == file.size;
+                                                   });
+                 byCrc != members.end())
+        {
+            member = &(*byCrc);
+        }
+
+        if (member == nullptr)
+        {
+            return Audit::MISSING_FILES;
+        }
+
+        if (member->size != file.size || member->crc != file.crc)
+        {
+            result = Audit::BAD_FILES;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,76 @@
+#include "rom/collation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <climits>
+
+namespace {
+// Anything outside ascii is part of some utf-8 sequence, we consider it significant
+bool isSignificant(unsigned char character)
+{
+    return std::isalnum(character) != 0 || character >= 0x80; // NOLINT
+}
+
+std::string_view skipPunctuation(std::string_view text)
+{
+    auto first = std::ranges::find_if(text, [](char character) { return isSignificant(character); });
+    return text.substr(static_cast<std::size_t>(first - text.begin()));
+}
+
+char lower(char character)
+{
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(character)));
+}
+
+bool startsWithIgnoringCase(std::string_view text, std::string_view prefix)
+{
+    return text.size() >= prefix.size() && std::ranges::equal(text.substr(0, prefix.size()), prefix, {}, lower, lower);
+}
+
+std::string_view skipArticle(std::string_view text)
+{
+    static constexpr std::array<std::string_view, 3> ARTICLES{"the ", "an ", "a "};
+    for (const auto& article : ARTICLES)
+    {
+        // A title made of the article alone is left as it is
+        if (text.size() > article.size() && startsWithIgnoringCase(text, article))
+        {
+            return skipPunctuation(text.substr(article.size()));
+        }
+    }
+
+    return text;
+}
+} // namespace
+
+std::string Rom::collationKey(std::string_view text)
+{
+    text = skipArticle(skipPunctuation(text));
+
+    std::string result;
+    result.reserve(text.size() + 1);
+    for (std::size_t i = 0; i < text.size();)
+    {
+        const auto character = static_cast<unsigned char>(text[i]);
+        if (std::isdigit(character) == 0)
+        {
+            result.push_back(lower(text[i]));
+            i++;
+            continue;
+        }
+
+        // A number is written as its digit count followed by its digits: a shorter number is a smaller one, numbers
+        // with the same digit count compare digit by digit. Leading zeroes don't count.
+        auto end = text.find_first_not_of("0123456789", i);
+        auto number = text.substr(i, end == std::string_view::npos ? std::string_view::npos : end - i);
+        auto significant = number.find_first_not_of('0');
+        number = significant == std::string_view::npos ? number.substr(number.size() - 1) : number.substr(significant);
+
+        result.push_back(static_cast<char>(std::min<std::size_t>(number.size(), CHAR_MAX)));
+        result.append(number);
+        i += end == std::string_view::npos ? text.size() - i : end - i;
+    }
+
+    return result;
+}
@@ -1,19 +1,16 @@
 #include "rom/folder.hpp"
 
-#include <cstring>
-#include <dirent.h>
 #include <fstream>
-#include <sys/stat.h>
-#include <sys/types.h>
-#include <unistd.h>
 
 #include <spdlog/spdlog.h>
 
+#include "utils/filesystem.hpp"
+
 std::vector<std::filesystem::path> Rom::Folder::scan() const
 {
     std::vector<std::filesystem::path> result;
     std::string listLog(fmt::format(R"(Rom scan operation on folder "{}".)", mFolderPath.string()));
-    auto entries = fileList(mFolderPath);
+    auto entries = utils::filesystem::fileList(mFolderPath);
     for (const auto& entry : entries)
     {
         if (std::filesystem::is_regular_file(entry))
@@ -28,73 +25,6 @@ std::vector<std::filesystem::path> Rom::Folder::scan() const
     return result;
 }
 
-std::vector<std::filesystem::path> Rom::Folder::fileList(const std::filesystem::path& folder) const
-{
-    /* We provide two different implementations to iterate over the content of a folder:
-        1. The first one uses POSIX API
-        2. The second one uses std::filesystem::recursive_directory_iterator
-
-        For some reasons our toolchain adds some strange symbols when using recursive_directory_iterator.
-        These symbols are generally unavailable on raspbian (?) and this makes the executable unusable.
-        For this reason we use the POSIX API when compiling arm so we don't break raspbian compatibility.
-        This issue should be investigated.
-    */
-    std::vector<std::filesystem::path> result;
-
-#ifdef USE_POSIX_FILE_LIST
-    DIR* dp;
-    struct dirent* entry;
-    struct stat info;
-
-    if ((dp = opendir(folder.c_str())) == NULL)
-    {
-        return result;
-    }
-
-    while ((entry = readdir(dp)) != NULL)
-    {
-        std::filesystem::path path = folder / entry->d_name;
-
-        if (stat(path.c_str(), &info) != 0)
-        {
-            continue;
-        }
-
-        if (S_ISDIR(info.st_mode))
-        {
-            // Skip "." and ".." directories
-            if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
-            {
-                // Recurse into subdirectories
-                std::vector<std::filesystem::path> subDirFiles = fileList(path);
-                result.insert(result.end(), subDirFiles.begin(), subDirFiles.end());
-            }
-        }
-        else
-        {
-            // It's a file, add to list
-            result.push_back(path);
-        }
-    }
-
-    closedir(dp);
-#else
-    try
-    {
-        for (const auto& entry : std::filesystem::recursive_directory_iterator(folder))
-        {
-            result.push_back(std::filesystem::absolute(entry.path()));
-        }
-    }
-    catch (const std::filesystem::filesystem_error&)
-    {
-        return std::vector<std::filesystem::path>();
-    }
-#endif
-
-    return result;
-}
-
 std::optional<std::string> Rom::Folder::lastModified() const
 {
     std::error_code errorCode;
@@ -111,7 +41,7 @@ std::optional<std::string> Rom::Folder::lastModified() const
     }
 
     // Then we scan all the subfolders for edit times
-    auto entries = fileList(mFolderPath);
+    auto entries = utils::filesystem::fileList(mFolderPath);
     for (const auto& entry : entries)
     {
         if (lastModified = std::filesystem::last_write_time(entry, errorCode);
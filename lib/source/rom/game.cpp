@@ -1,24 +1,35 @@
 #include "rom/game.hpp"
 
-Rom::Game::Game(const std::filesystem::path& path, const Rom::Info& info, const std::optional<Rom::Media>& media)
-    : mPath(path), mInfo(info), mMedia(media)
+Rom::Game::Game(std::filesystem::path path, Rom::Info info, std::optional<Rom::Media> media,
+                std::optional<Rom::Audit> audit)
+    : mPath(std::move(path)), mInfo(std::move(info)), mMedia(std::move(media)), mAudit(audit)
 {}
 
-std::filesystem::path Rom::Game::path() const
+const std::filesystem::path& Rom::Game::path() const
 {
     return mPath;
 }
 
-Rom::Info Rom::Game::info() const
+const Rom::Info& Rom::Game::info() const
 {
     return mInfo;
 }
 
-std::optional<Rom::Media> Rom::Game::media() const
+std::string_view Rom::Game::title() const
+{
+    return mInfo.title;
+}
+
+const std::optional<Rom::Media>& Rom::Game::media() const
 {
     return mMedia;
 }
 
+std::optional<Rom::Audit> Rom::Game::audit() const
+{
+    return mAudit;
+}
+
 bool Rom::Game::operator==(const Game& rom) const
 {
     return this->mPath == rom.mPath;
@@ -26,5 +37,5 @@ bool Rom::Game::operator==(const Game& rom) const
 
 std::string Rom::Game::toString() const
 {
-    return info().title;
+    return mInfo.title;
 }
@@ -0,0 +1,198 @@
+#include "rom/library.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "rom/collation.hpp"
+
+Rom::Library::Index Rom::Library::StringPool::intern(std::string_view string)
+{
+    if (auto found = mIds.find(string); found != mIds.end())
+    {
+        return found->second;
+    }
+
+    const auto id = static_cast<Index>(mStrings.size());
+    const auto& stored = mStrings.emplace_back(string);
+    mIds.emplace(stored, id);
+    return id;
+}
+
+Rom::Library::Slice Rom::Library::store(std::string_view string)
+{
+    Slice result{.offset = static_cast<Index>(mCharacters.size()), .length = static_cast<Index>(string.size())};
+    mCharacters.append(string);
+    return result;
+}
+
+std::string_view Rom::Library::view(const Slice& slice) const
+{
+    return std::string_view(mCharacters).substr(slice.offset, slice.length);
+}
+
+Rom::Library::Index Rom::Library::intern(const std::optional<std::string>& string)
+{
+    return string ? mPool.intern(*string) : NONE;
+}
+
+std::optional<std::string_view> Rom::Library::interned(Index id) const
+{
+    if (id == NONE)
+    {
+        return std::nullopt;
+    }
+
+    return mPool[id];
+}
+
+void Rom::Library::reserve(std::size_t size)
+{
+    mDirectories.reserve(size);
+    mFileNames.reserve(size);
+    mTitles.reserve(size);
+    mTitleKeys.reserve(size);
+    mYears.reserve(size);
+    mManufacturers.reserve(size);
+    mManufacturerKeys.reserve(size);
+    mIsBios.reserve(size);
+    mAudits.reserve(size);
+    mParents.reserve(size);
+    mBioses.reserve(size);
+    mScreenshotDirectories.reserve(size);
+    mScreenshotNames.reserve(size);
+}
+
+Rom::Library::Index Rom::Library::add(const Rom::Game& game)
+{
+    const auto& path = game.path();
+    const auto& info = game.info();
+    const auto& media = game.media();
+
+    // Narrow strings on every platform, native() is a wide string on Windows. Entries build paths back from them
+    mDirectories.push_back(mPool.intern(path.parent_path().string()));
+    mFileNames.push_back(store(path.filename().string()));
+    mTitles.push_back(store(info.title));
+    mTitleKeys.push_back(store(Rom::collationKey(info.title)));
+    mYears.push_back(intern(info.year));
+    mManufacturers.push_back(intern(info.manufacturer));
+    mManufacturerKeys.push_back(info.manufacturer ? mPool.intern(Rom::collationKey(*info.manufacturer)) : NONE);
+    mIsBios.push_back(info.isBios);
+    mAudits.push_back(game.audit());
+    mParents.push_back(intern(info.parent));
+    mBioses.push_back(intern(info.bios));
+
+    if (media && media->screenshot)
+    {
+        mScreenshotDirectories.push_back(mPool.intern(media->screenshot->parent_path().string()));
+        mScreenshotNames.push_back(store(media->screenshot->filename().string()));
+    }
+    else
+    {
+        mScreenshotDirectories.push_back(NONE);
+        mScreenshotNames.push_back(Slice{.offset = 0, .length = 0});
+    }
+
+    return static_cast<Index>(size() - 1);
+}
+
+std::vector<Rom::Library::Index> Rom::Library::orderByTitle() const
+{
+    std::vector<Index> result(size());
+    std::iota(result.begin(), result.end(), 0);
+    std::ranges::sort(result, [this](Index first, Index second) {
+        return std::pair(view(mTitleKeys[first]), first) < std::pair(view(mTitleKeys[second]), second);
+    });
+
+    return result;
+}
+
+std::filesystem::path Rom::Library::Entry::path() const
+{
+    return std::filesystem::path(mLibrary->mPool[mLibrary->mDirectories[mIndex]]) / fileName();
+}
+
+std::string_view Rom::Library::Entry::fileName() const
+{
+    return mLibrary->view(mLibrary->mFileNames[mIndex]);
+}
+
+std::string_view Rom::Library::Entry::stem() const
+{
+    auto name = fileName();
+    auto extension = name.find_last_of('.');
+    return extension == std::string_view::npos || extension == 0 ? name : name.substr(0, extension);
+}
+
+std::string_view Rom::Library::Entry::title() const
+{
+    return mLibrary->view(mLibrary->mTitles[mIndex]);
+}
+
+std::string_view Rom::Library::Entry::titleKey() const
+{
+    return mLibrary->view(mLibrary->mTitleKeys[mIndex]);
+}
+
+std::optional<std::string_view> Rom::Library::Entry::year() const
+{
+    return mLibrary->interned(mLibrary->mYears[mIndex]);
+}
+
+std::optional<std::string_view> Rom::Library::Entry::manufacturer() const
+{
+    return mLibrary->interned(mLibrary->mManufacturers[mIndex]);
+}
+
+std::optional<std::string_view> Rom::Library::Entry::manufacturerKey() const
+{
+    return mLibrary->interned(mLibrary->mManufacturerKeys[mIndex]);
+}
+
+std::optional<std::filesystem::path> Rom::Library::Entry::screenshot() const
+{
+    auto directory = mLibrary->interned(mLibrary->mScreenshotDirectories[mIndex]);
+    if (!directory)
+    {
+        return std::nullopt;
+    }
+
+    return std::filesystem::path(*directory) / mLibrary->view(mLibrary->mScreenshotNames[mIndex]);
+}
+
+std::optional<Rom::Audit> Rom::Library::Entry::audit() const
+{
+    return mLibrary->mAudits[mIndex];
+}
+
+std::optional<std::string_view> Rom::Library::Entry::parent() const
+{
+    return mLibrary->interned(mLibrary->mParents[mIndex]);
+}
+
+std::optional<std::string_view> Rom::Library::Entry::bios() const
+{
+    return mLibrary->interned(mLibrary->mBioses[mIndex]);
+}
+
+Rom::Game Rom::Library::Entry::game() const
+{
+    auto optionalString = [](const std::optional<std::string_view>& view) -> std::optional<std::string> {
+        return view ? std::optional<std::string>(*view) : std::nullopt;
+    };
+
+    Rom::Info info{.title{std::string(title())},
+                   .year{optionalString(year())},
+                   .manufacturer{optionalString(manufacturer())},
+                   .isBios{mLibrary->mIsBios[mIndex]},
+                   .parent{optionalString(parent())},
+                   .bios{optionalString(bios())}};
+
+    std::optional<Rom::Media> media;
+    if (auto romScreenshot = screenshot(); romScreenshot)
+    {
+        media = Rom::Media{.screenshot{romScreenshot}};
+    }
+
+    return Rom::Game(path(), std::move(info), std::move(media), audit());
+}
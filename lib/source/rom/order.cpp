@@ -0,0 +1,43 @@
+#include "rom/order.hpp"
+
+#include <optional>
+#include <string_view>
+
+namespace {
+// Missing values are sorted last, equivalent values are then sorted by title
+bool precedesOnOptional(const std::optional<std::string_view>& first, const std::optional<std::string_view>& second,
+                        const Rom::Library::Entry& firstEntry, const Rom::Library::Entry& secondEntry)
+{
+    if (first.has_value() != second.has_value())
+    {
+        return first.has_value();
+    }
+
+    if (first != second)
+    {
+        return first < second;
+    }
+
+    return firstEntry.titleKey() < secondEntry.titleKey();
+}
+} // namespace
+
+bool Rom::precedes(Rom::Sort sort, const Rom::Library::Entry& first, const Rom::Library::Entry& second)
+{
+    switch (sort)
+    {
+        case Rom::Sort::YEAR:
+        {
+            return precedesOnOptional(first.year(), second.year(), first, second);
+        }
+        case Rom::Sort::MANUFACTURER:
+        {
+            return precedesOnOptional(first.manufacturerKey(), second.manufacturerKey(), first, second);
+        }
+        case Rom::Sort::TITLE:
+        default:
+        {
+            return first.titleKey() < second.titleKey();
+        }
+    }
+}
@@ -0,0 +1,154 @@
+#include "rom/prefetcher.hpp"
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#ifdef TARGET_OS_LINUX
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef TARGET_OS_LINUX
+// From linux/ioprio.h, which older kernel headers lack
+constexpr int IOPRIO_WHO_PROCESS = 1;
+constexpr int IOPRIO_CLASS_IDLE = 3;
+constexpr int IOPRIO_CLASS_SHIFT = 13;
+#endif
+} // namespace
+
+Rom::Prefetcher::Prefetcher(std::uint64_t budget) : mBudget(budget), mWorker(&Prefetcher::work, this) {}
+
+std::vector<std::filesystem::path> Rom::Prefetcher::files(const Rom::Library::Entry& rom)
+{
+    auto path = rom.path();
+    std::vector<std::filesystem::path> result{path};
+
+    for (auto set : {rom.parent(), rom.bios()})
+    {
+        if (!set)
+        {
+            continue;
+        }
+
+        auto candidate = path.parent_path() / std::filesystem::path(*set).replace_extension(path.extension());
+        if (std::error_code ec; std::filesystem::is_regular_file(candidate, ec))
+        {
+            result.push_back(std::move(candidate));
+        }
+    }
+
+    return result;
+}
+
+void Rom::Prefetcher::prefetch(std::vector<std::filesystem::path> files)
+{
+    std::lock_guard lock(mMutex);
+    mFiles = std::move(files);
+    mGeneration++;
+    mCondition.notify_all();
+}
+
+void Rom::Prefetcher::cancel()
+{
+    std::lock_guard lock(mMutex);
+    mFiles.clear();
+    mGeneration++;
+    mDone = mGeneration;
+    mCondition.notify_all();
+}
+
+void Rom::Prefetcher::wait()
+{
+    std::unique_lock lock(mMutex);
+    mCondition.wait(lock, [this]() { return mDone == mGeneration; });
+}
+
+void Rom::Prefetcher::work()
+{
+#ifdef TARGET_OS_LINUX
+    // Applies to this thread only: reading ahead never slows down anybody else's I/O
+    if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT) != 0)
+    {
+        spdlog::debug(R"(Could not lower the prefetcher I/O priority: "{}")", std::strerror(errno));
+    }
+#endif
+
+    std::unique_lock lock(mMutex);
+    while (true)
+    {
+        mCondition.wait(lock, [this]() { return mStopping || mDone != mGeneration; });
+        if (mStopping)
+        {
+            return;
+        }
+
+        const std::uint64_t generation = mGeneration;
+        auto files = std::move(mFiles);
+        mFiles.clear();
+
+        lock.unlock();
+        std::uint64_t budget = mBudget;
+        for (const auto& file : files)
+        {
+            prefetch(file, generation, budget);
+        }
+        lock.lock();
+
+        // A request which came in meanwhile is picked up at the next round
+        if (mGeneration == generation)
+        {
+            mDone = generation;
+            mCondition.notify_all();
+        }
+    }
+}
+
+void Rom::Prefetcher::prefetch(const std::filesystem::path& file, std::uint64_t generation, std::uint64_t& budget)
+{
+#ifdef TARGET_OS_LINUX
+    const int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        spdlog::debug(R"(Prefetch operation on "{}". Could not open file: "{}")", file.string(), std::strerror(errno));
+        return;
+    }
+
+    struct stat status = {};
+    const auto size = fstat(fd, &status) == 0 ? static_cast<std::uint64_t>(status.st_size) : 0;
+
+    std::uint64_t offset = 0;
+    while (offset < size && budget > 0 && mGeneration == generation)
+    {
+        const auto length = std::min({CHUNK, budget, size - offset});
+        // Blocks until the chunk is in the page cache, which is what keeps cancellation within a chunk
+        if (readahead(fd, static_cast<off64_t>(offset), length) != 0)
+        {
+            break;
+        }
+
+        offset += length;
+        budget -= length;
+        mPrefetched += length;
+    }
+
+    close(fd);
+#endif
+}
+
+Rom::Prefetcher::~Prefetcher()
+{
+    {
+        std::lock_guard lock(mMutex);
+        mStopping = true;
+        mGeneration++;
+        mCondition.notify_all();
+    }
+
+    mWorker.join();
+}
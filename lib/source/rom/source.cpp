@@ -1,6 +1,12 @@
 #include "rom/source.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <future>
+#include <memory>
+#include <thread>
+#include <unordered_map>
 
 #include <spdlog/spdlog.h>
 
@@ -11,7 +17,7 @@ void Rom::Source::monitor()
         std::string monitorLog(fmt::format(R"(Rom monitor operation on "{}".)", mIdentifier));
         auto cachedRoms = cache();
 
-        auto roms = cachedRoms ? *cachedRoms : [this, &monitorLog]() {
+        auto roms = cachedRoms ? std::move(*cachedRoms) : [this, &monitorLog]() {
             mLastModified = lastModified();
             if (!mLastModified)
             {
@@ -23,21 +29,32 @@ void Rom::Source::monitor()
             return parse();
         }();
 
+        // Roms go straight into the library, it is the only copy of them this source keeps
+        auto library = std::make_shared<Rom::Library>();
+        library->reserve(roms.size());
         for (const auto& rom : roms)
         {
-            if (rom.info().isLaunchable())
+            if (!rom.info().isLaunchable())
             {
-                spdlog::trace(R"({} Found rom "{}")", monitorLog, rom.info().title);
-                addElement(rom);
+                spdlog::trace(R"({} Rom: "{}" does not look like a launchable a rom, will not be added)", monitorLog,
+                              rom);
+            }
+            else if (auto romAudit = rom.audit(); romAudit && *romAudit != Rom::Audit::GOOD)
+            {
+                spdlog::debug(R"({} Rom: "{}" failed its audit ({}), will not be added)", monitorLog, rom,
+                              magic_enum::enum_name(*romAudit));
             }
             else
             {
-                spdlog::trace(R"({} Rom: "{}" does not look like a launchable a rom, will not be added)", monitorLog,
-                              rom);
+                spdlog::trace(R"({} Found rom "{}")", monitorLog, rom.title());
+                library->add(rom);
             }
         }
 
-        spdlog::info("{} Successfully retrieved {} roms", monitorLog, elements().size());
+        const auto size = library->size();
+        mLibrary.publish(std::move(library));
+
+        spdlog::info("{} Successfully retrieved {} roms", monitorLog, size);
     });
 }
 
@@ -150,47 +167,116 @@ std::optional<std::vector<Rom::Game>> Rom::Source::cache() const
 
 std::vector<Rom::Game> Rom::Source::parse() const
 {
-    std::vector<Rom::Game> result;
+    struct Candidate
+    {
+        std::filesystem::path path;
+        Rom::Definition definition;
+        std::optional<std::filesystem::path> screenshot;
+    };
+
+    std::vector<Candidate> candidates;
     std::string scanLog("Rom parse operation.");
     auto files = scan();
+
+    // Screenshots are associated to roms by stem, if more than one shares a stem the last one listed wins
+    std::unordered_map<std::string, std::filesystem::path> screenshots;
+    for (const auto& image : files | std::ranges::views::filter([](const std::filesystem::path& path) {
+                                 return path.extension() == ".png" || path.extension() == ".jpeg" ||
+                                        path.extension() == ".jpg";
+                             }))
+    {
+        screenshots.insert_or_assign(image.stem().string(), image);
+    }
+
     for (const auto& rom : files | std::ranges::views::filter(
                                        [](const std::filesystem::path& path) { return path.extension() == ".zip"; }))
     {
-        auto info = romInfo(rom);
+        auto romDefinition = definition(rom);
 
-        if (!info)
+        if (!romDefinition)
         {
             spdlog::trace(R"({} File: "{}" does not look like a rom, will not be added)", scanLog, rom.string());
             continue;
         }
 
-        // Searching for any screenshot associated to this rom
         std::optional<std::filesystem::path> screenshot;
-        for (const auto& image : files | std::ranges::views::filter([](const std::filesystem::path& path) {
-                                     return path.extension() == ".png" || path.extension() == ".jpeg" ||
-                                            path.extension() == ".jpg";
-                                 }))
+        if (auto found = screenshots.find(rom.stem().string()); found != screenshots.end())
         {
-            if (image.stem() == rom.stem())
-            {
-                screenshot = image;
-            }
+            screenshot = found->second;
+        }
+
+        candidates.push_back(
+            Candidate{.path{rom}, .definition{std::move(*romDefinition)}, .screenshot{std::move(screenshot)}});
+    }
+
+    // Auditing is pure I/O on the archive tails, we spread it on every available core
+    std::vector<Rom::Audit> audits(candidates.size(), Rom::Audit::GOOD);
+    std::atomic<std::size_t> next = 0;
+    auto auditWorker = [this, &candidates, &audits, &next]() {
+        for (auto i = next++; i < candidates.size(); i = next++)
+        {
+            audits[i] = audit(candidates[i].path, candidates[i].definition);
         }
+    };
+
+    const auto workerCount =
+        std::min<std::size_t>(std::max(1U, std::thread::hardware_concurrency()), candidates.size());
+    std::vector<std::future<void>> workers;
+    for (std::size_t i = 0; i < workerCount; i++)
+    {
+        workers.push_back(std::async(std::launch::async, auditWorker));
+    }
 
-        result.emplace_back(rom, *info, Rom::Media{.screenshot{screenshot}});
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+
+    // Member lists are only needed for the audit, games keep just its result
+    std::vector<Rom::Game> result;
+    result.reserve(candidates.size());
+    for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+        auto& candidate = candidates[i];
+        result.emplace_back(std::move(candidate.path), std::move(candidate.definition.info),
+                            Rom::Media{.screenshot{std::move(candidate.screenshot)}}, audits[i]);
     }
 
     return result;
 }
 
-std::optional<Rom::Info> Rom::Source::romInfo(const std::filesystem::path& path) const
+std::optional<Rom::Definition> Rom::Source::definition(const std::filesystem::path& path) const
 {
-    std::optional<Rom::Info> result;
+    std::optional<Rom::Definition> result;
     std::ignore = Rom::Database::get().find(path.stem().string()).matchRight([&result](auto&& rom) { result = rom; });
 
     return result;
 }
 
+Rom::Audit Rom::Source::audit(const std::filesystem::path& path, const Rom::Definition& definition) const
+{
+    std::string auditLog(fmt::format(R"(Audit operation on "{}".)", path.string()));
+
+    auto members = Rom::Archive::members(path);
+    if (members.isLeft())
+    {
+        spdlog::debug(R"({} Failed, archive could not be listed: "{}")", auditLog,
+                      magic_enum::enum_name(members.getLeft()));
+
+        return members.getLeft() == Rom::Archive::Error::OPEN_FILE ? Rom::Audit::UNREADABLE : Rom::Audit::CORRUPTED;
+    }
+
+    // Without a member list in the database we can only say that the archive is well formed
+    if (!definition.files)
+    {
+        return members.getRight().empty() ? Rom::Audit::MISSING_FILES : Rom::Audit::GOOD;
+    }
+
+    auto result = Rom::Archive::audit(members.getRight(), *definition.files);
+    spdlog::trace("{} Result: {}", auditLog, magic_enum::enum_name(result));
+    return result;
+}
+
 std::optional<nlohmann::json> Rom::Source::readCacheFile(const std::filesystem::path& path) const
 {
     std::string cacheLog(fmt::format(R"(Cache read operation from "{}".)", path.string()));
@@ -236,10 +322,9 @@ bool Rom::Source::writeCache() const
     json[VERSION_JSON_FIELD] = version();
 
     nlohmann::json jsonRoms;
-    auto roms = elements();
-    for (const auto& rom : roms)
+    for (const auto& rom : *mLibrary.load())
     {
-        jsonRoms.push_back(rom);
+        jsonRoms.push_back(rom.game());
     }
 
     json[ROMS_JSON_FIELD] = jsonRoms;
@@ -0,0 +1,375 @@
+#include "schedulingpolicy.hpp"
+
+#include <fstream>
+
+#include <fmt/ranges.h>
+#include <magic_enum.hpp>
+#include <spdlog/spdlog.h>
+
+#include "exception.hpp"
+
+#ifdef TARGET_OS_LINUX
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef TARGET_OS_LINUX
+cpu_set_t cpuSet(const std::vector<unsigned int>& cores)
+{
+    cpu_set_t result;
+    CPU_ZERO(&result);
+    for (auto core : cores)
+    {
+        if (core < CPU_SETSIZE)
+        {
+            CPU_SET(core, &result);
+        }
+    }
+
+    return result;
+}
+
+cpu_set_t allCores()
+{
+    cpu_set_t result;
+    CPU_ZERO(&result);
+    for (long core = 0; core < sysconf(_SC_NPROCESSORS_CONF) && core < CPU_SETSIZE; core++)
+    {
+        CPU_SET(core, &result);
+    }
+
+    return result;
+}
+
+int linuxScheduler(SchedulingPolicy::Scheduler scheduler)
+{
+    switch (scheduler)
+    {
+        case SchedulingPolicy::Scheduler::OTHER:
+        {
+            return SCHED_OTHER;
+        }
+        case SchedulingPolicy::Scheduler::BATCH:
+        {
+            return SCHED_BATCH;
+        }
+        case SchedulingPolicy::Scheduler::IDLE:
+        {
+            return SCHED_IDLE;
+        }
+        case SchedulingPolicy::Scheduler::FIFO:
+        {
+            return SCHED_FIFO;
+        }
+        case SchedulingPolicy::Scheduler::RR:
+        {
+            return SCHED_RR;
+        }
+    }
+
+    return SCHED_OTHER;
+}
+
+// Resources are plain ints on musl and an enum on glibc, RLIMIT_* constants have whichever type prlimit takes
+int linuxLimit(SchedulingPolicy::Limit limit)
+{
+    switch (limit)
+    {
+        case SchedulingPolicy::Limit::AS:
+        {
+            return RLIMIT_AS;
+        }
+        case SchedulingPolicy::Limit::CORE:
+        {
+            return RLIMIT_CORE;
+        }
+        case SchedulingPolicy::Limit::MEMLOCK:
+        {
+            return RLIMIT_MEMLOCK;
+        }
+        case SchedulingPolicy::Limit::NOFILE:
+        {
+            return RLIMIT_NOFILE;
+        }
+        case SchedulingPolicy::Limit::RTPRIO:
+        {
+            return RLIMIT_RTPRIO;
+        }
+    }
+
+    return RLIMIT_NOFILE;
+}
+
+// Writes a cgroup interface file in a single write, as the kernel expects. Returns 0 or the errno of the failure
+int writeFile(const std::filesystem::path& path, std::string_view content)
+{
+    int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return errno;
+    }
+
+    int result = 0;
+    auto written = write(fd, content.data(), content.size());
+    if (written < 0)
+    {
+        result = errno;
+    }
+    else if (static_cast<std::size_t>(written) != content.size())
+    {
+        // A short write sets no errno, the kernel did not take the whole value
+        result = EIO;
+    }
+
+    if (close(fd) != 0 && result == 0)
+    {
+        result = errno;
+    }
+
+    return result;
+}
+#endif
+} // namespace
+
+SchedulingPolicy SchedulingPolicy::fromFile(const std::filesystem::path& path)
+{
+    const std::string readLog = fmt::format(R"(Scheduling policy read operation from "{}".)", path.string());
+
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        spdlog::debug("{} No policy file, using the default policy", readLog);
+        return {};
+    }
+
+    try
+    {
+        return nlohmann::json::parse(file).get<SchedulingPolicy>();
+    }
+    catch (const nlohmann::json::exception& excep)
+    {
+        spdlog::warn(R"({} Failed, using the default policy. Underlying json library threw "{}")", readLog,
+                     excep.what());
+    }
+    catch (const enea::Exception& excep)
+    {
+        spdlog::warn(R"({} Failed, using the default policy: "{}")", readLog, excep.what());
+    }
+
+    return {};
+}
+
+void SchedulingPolicy::pinEnea() const
+{
+    if (!eneaCores)
+    {
+        return;
+    }
+
+#ifdef TARGET_OS_LINUX
+    auto cores = cpuSet(*eneaCores);
+    if (sched_setaffinity(0, sizeof(cores), &cores) != 0)
+    {
+        spdlog::warn(R"(Could not pin Enea to cores {}: "{}")", *eneaCores, std::strerror(errno));
+        return;
+    }
+
+    spdlog::info("Enea pinned to cores {}", *eneaCores);
+#else
+    spdlog::warn("Pinning Enea to cores is not supported on this platform");
+#endif
+}
+
+#ifdef TARGET_OS_LINUX
+void SchedulingPolicy::apply(pid_t pid) const
+{
+    const std::string applyLog = fmt::format("Scheduling policy application to process {}.", pid);
+    auto warn = [&applyLog](std::string_view setting, std::string_view reason) {
+        spdlog::warn(R"({} Could not set {}: "{}")", applyLog, setting, reason);
+    };
+    auto check = [&warn](bool failed, std::string_view setting) {
+        if (failed)
+        {
+            warn(setting, std::strerror(errno));
+        }
+    };
+    auto checkWrite = [&warn](int error, std::string_view setting) {
+        if (error != 0)
+        {
+            warn(setting, std::strerror(error));
+        }
+    };
+
+    // The cgroup goes first, so its controllers apply to everything the process does from now on
+    if (cgroup)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(*cgroup, ec);
+        if (ec)
+        {
+            warn(fmt::format("cgroup {}", cgroup->string()), ec.message());
+        }
+        else
+        {
+            for (const auto& [setting, value] : cgroupSettings)
+            {
+                checkWrite(writeFile(*cgroup / setting, value), fmt::format("cgroup {}", setting));
+            }
+
+            checkWrite(writeFile(*cgroup / "cgroup.procs", std::to_string(pid)), "cgroup");
+        }
+    }
+
+    // If Enea is pinned the process inherited that, it gets every core back unless told otherwise
+    if (emulatorCores || eneaCores)
+    {
+        auto cores = emulatorCores ? cpuSet(*emulatorCores) : allCores();
+        check(sched_setaffinity(pid, sizeof(cores), &cores) != 0, "cpu affinity");
+    }
+
+    if (niceness)
+    {
+        check(setpriority(PRIO_PROCESS, static_cast<id_t>(pid), *niceness) != 0, "niceness");
+    }
+
+    if (scheduler)
+    {
+        sched_param parameters{};
+        parameters.sched_priority = priority.value_or(0);
+        check(sched_setscheduler(pid, linuxScheduler(*scheduler), &parameters) != 0, "scheduler");
+    }
+
+    for (const auto& [limit, value] : limits)
+    {
+        rlimit resourceLimit{.rlim_cur = value, .rlim_max = value};
+        const auto resource = static_cast<decltype(RLIMIT_CORE)>(linuxLimit(limit));
+        check(prlimit(pid, resource, &resourceLimit, nullptr) != 0,
+              fmt::format("limit {}", magic_enum::enum_name(limit)));
+    }
+
+    if (!empty())
+    {
+        spdlog::info("{} Applied {}", applyLog, *this);
+    }
+}
+#endif
+
+bool SchedulingPolicy::empty() const
+{
+    return *this == SchedulingPolicy{};
+}
+
+std::string SchedulingPolicy::toString() const
+{
+    if (empty())
+    {
+        return "default policy";
+    }
+
+    std::vector<std::string> settings;
+    if (emulatorCores)
+    {
+        settings.push_back(fmt::format("emulator cores {}", *emulatorCores));
+    }
+
+    if (eneaCores)
+    {
+        settings.push_back(fmt::format("Enea cores {}", *eneaCores));
+    }
+
+    if (niceness)
+    {
+        settings.push_back(fmt::format("niceness {}", *niceness));
+    }
+
+    if (scheduler)
+    {
+        settings.push_back(
+            fmt::format("scheduler {} priority {}", magic_enum::enum_name(*scheduler), priority.value_or(0)));
+    }
+
+    for (const auto& [limit, value] : limits)
+    {
+        settings.push_back(fmt::format("limit {} {}", magic_enum::enum_name(limit), value));
+    }
+
+    if (cgroup)
+    {
+        settings.push_back(fmt::format("cgroup {}", cgroup->string()));
+    }
+
+    return fmt::format("{}", fmt::join(settings, ", "));
+}
+
+void to_json(nlohmann::json& json, const SchedulingPolicy& policy)
+{
+    json.clear();
+
+    utils::addOptionalToJson(json, SchedulingPolicy::EMULATORCORES_JSON_FIELD, policy.emulatorCores);
+    utils::addOptionalToJson(json, SchedulingPolicy::ENEACORES_JSON_FIELD, policy.eneaCores);
+    utils::addOptionalToJson(json, SchedulingPolicy::NICENESS_JSON_FIELD, policy.niceness);
+    if (policy.scheduler)
+    {
+        json[SchedulingPolicy::SCHEDULER_JSON_FIELD] = magic_enum::enum_name(*policy.scheduler);
+    }
+    utils::addOptionalToJson(json, SchedulingPolicy::PRIORITY_JSON_FIELD, policy.priority);
+    for (const auto& [limit, value] : policy.limits)
+    {
+        json[SchedulingPolicy::LIMITS_JSON_FIELD][magic_enum::enum_name(limit)] = value;
+    }
+    if (policy.cgroup)
+    {
+        json[SchedulingPolicy::CGROUP_JSON_FIELD] = policy.cgroup->string();
+    }
+    if (!policy.cgroupSettings.empty())
+    {
+        json[SchedulingPolicy::CGROUPSETTINGS_JSON_FIELD] = policy.cgroupSettings;
+    }
+}
+
+void from_json(const nlohmann::json& json, SchedulingPolicy& policy)
+{
+    policy.emulatorCores =
+        utils::getOptionalValueFromJson<std::vector<unsigned int>>(json, SchedulingPolicy::EMULATORCORES_JSON_FIELD);
+    policy.eneaCores =
+        utils::getOptionalValueFromJson<std::vector<unsigned int>>(json, SchedulingPolicy::ENEACORES_JSON_FIELD);
+    policy.niceness = utils::getOptionalValueFromJson<int>(json, SchedulingPolicy::NICENESS_JSON_FIELD);
+    policy.priority = utils::getOptionalValueFromJson<int>(json, SchedulingPolicy::PRIORITY_JSON_FIELD);
+
+    policy.scheduler = std::nullopt;
+    if (auto scheduler = utils::getOptionalValueFromJson<std::string>(json, SchedulingPolicy::SCHEDULER_JSON_FIELD);
+        scheduler)
+    {
+        policy.scheduler = magic_enum::enum_cast<SchedulingPolicy::Scheduler>(*scheduler);
+        if (!policy.scheduler)
+        {
+            throw enea::json::Exception(fmt::format(R"(Unknown scheduler "{}")", *scheduler), json);
+        }
+    }
+
+    policy.limits.clear();
+    auto limits = utils::getOptionalValueFromJson<std::map<std::string, std::uint64_t>>(
+        json, SchedulingPolicy::LIMITS_JSON_FIELD);
+    for (const auto& [name, value] : limits.value_or(std::map<std::string, std::uint64_t>{}))
+    {
+        auto limit = magic_enum::enum_cast<SchedulingPolicy::Limit>(name);
+        if (!limit)
+        {
+            throw enea::json::Exception(fmt::format(R"(Unknown limit "{}")", name), json);
+        }
+
+        policy.limits[*limit] = value;
+    }
+
+    auto cgroup = utils::getOptionalValueFromJson<std::string>(json, SchedulingPolicy::CGROUP_JSON_FIELD);
+    policy.cgroup = cgroup ? std::optional<std::filesystem::path>(*cgroup) : std::nullopt;
+    policy.cgroupSettings =
+        utils::getOptionalValueFromJson<std::map<std::string, std::string>>(json,
+                                                                           SchedulingPolicy::CGROUPSETTINGS_JSON_FIELD)
+            .value_or(std::map<std::string, std::string>{});
+}
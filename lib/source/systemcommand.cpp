@@ -1,48 +1,156 @@
 #include "systemcommand.hpp"
 
+#include <algorithm>
 #include <array>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <thread>
 
 #include <fmt/format.h>
 #include <magic_enum.hpp>
 #include <spdlog/spdlog.h>
 
-ChefFun::Either<SYSTEM2_RESULT, SystemCommand::Output> SystemCommand::launchCmd() const
+#ifdef TARGET_OS_LINUX
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "launcher.hpp"
+#endif
+
+namespace {
+// Whatever the output size, at most its last bytes end up in the logs
+constexpr std::size_t LOGGED_OUTPUT_LIMIT = 1024;
+
+std::string_view loggedOutput(std::string_view output)
+{
+    return output.substr(output.size() - std::min(output.size(), LOGGED_OUTPUT_LIMIT));
+}
+
+ChefFun::Either<SYSTEM2_RESULT, SystemCommand::Output> runCommand(const std::string& cmd)
 {
     // Launching command
     System2CommandInfo commandInfo = {};
     commandInfo.RedirectOutput = true;
-    if (auto result = System2CppRun(mCmd, commandInfo); result != SYSTEM2_RESULT_SUCCESS)
+    if (auto result = System2CppRun(cmd, commandInfo); result != SYSTEM2_RESULT_SUCCESS)
     {
-        return ChefFun::Either<SYSTEM2_RESULT, Output>::Left(result);
+        return ChefFun::Either<SYSTEM2_RESULT, SystemCommand::Output>::Left(result);
     }
 
     // Getting command text output
     std::string output;
     if (auto result = System2CppReadFromOutput(commandInfo, output); result != SYSTEM2_RESULT_SUCCESS)
     {
-        return ChefFun::Either<SYSTEM2_RESULT, Output>::Left(result);
+        return ChefFun::Either<SYSTEM2_RESULT, SystemCommand::Output>::Left(result);
     }
 
     // Getting command return code
     int returnCode;
     if (auto result = System2CppGetCommandReturnValueSync(commandInfo, returnCode); result != SYSTEM2_RESULT_SUCCESS)
     {
-        return ChefFun::Either<SYSTEM2_RESULT, Output>::Left(result);
+        return ChefFun::Either<SYSTEM2_RESULT, SystemCommand::Output>::Left(result);
+    }
+
+    return ChefFun::Either<SYSTEM2_RESULT, SystemCommand::Output>::Right(SystemCommand::Output{returnCode, output});
+}
+
+// Joins an argument vector in a single command line, quoting what a shell would otherwise split
+std::string commandLine(const std::vector<std::string>& arguments)
+{
+    std::string result;
+    for (const auto& argument : arguments)
+    {
+        if (!result.empty())
+        {
+            result += ' ';
+        }
+
+        if (!argument.empty() && argument.find_first_of(" \t\"\\") == std::string::npos)
+        {
+            result += argument;
+            continue;
+        }
+
+        result += '"';
+        for (auto character : argument)
+        {
+            if (character == '"' || character == '\\')
+            {
+                result += '\\';
+            }
+            result += character;
+        }
+        result += '"';
     }
 
-    return ChefFun::Either<SYSTEM2_RESULT, Output>::Right(Output{returnCode, output});
+    return result;
+}
+} // namespace
+
+SystemCommand::SystemCommand(std::vector<std::string> arguments, std::optional<Environment> environment)
+    : mCmd(commandLine(arguments)), mArguments(std::move(arguments)), mEnvironment(std::move(environment))
+{}
+
+SystemCommand::Environment SystemCommand::environment()
+{
+#ifdef TARGET_OS_LINUX
+    char** variables = environ;
+#elif defined(TARGET_OS_WINDOWS)
+    char** variables = _environ;
+#else
+#error "Unknown target OS. Compilation halted."
+#endif
+
+    Environment result;
+    for (; variables != nullptr && *variables != nullptr; variables++)
+    {
+        std::string_view variable(*variables);
+        if (auto separator = variable.find('='); separator != std::string_view::npos && separator != 0)
+        {
+            result.emplace(variable.substr(0, separator), variable.substr(separator + 1));
+        }
+    }
+
+    return result;
+}
+
+ChefFun::Either<SYSTEM2_RESULT, SystemCommand::Output> SystemCommand::launchCmd() const
+{
+    return runCommand(mCmd);
 }
 
 ChefFun::Either<SystemCommand::Error, SystemCommand::Output> SystemCommand::launch() const
 {
     const std::string launchOperationLog = fmt::format(R"(Launched command: "{}".)", mCmd);
 
+#ifdef TARGET_OS_LINUX
+    // System2 always goes through a shell, argument vectors are spawned directly
+    if (!mArguments.empty())
+    {
+        auto process = spawn();
+        if (process.isLeft())
+        {
+            return ChefFun::Either<Error, Output>::Left(process.getLeft());
+        }
+
+        auto output = process.getRight()->wait();
+        spdlog::debug(R"({} Command exited with exit code: "{}", with output "{}")", launchOperationLog,
+                      output.exitCode, loggedOutput(output.output));
+        return ChefFun::Either<Error, Output>::Right(output);
+    }
+#endif
+
     return launchCmd()
         .matchRight([&launchOperationLog](auto&& output) {
             spdlog::debug(R"({} Command exited with exit code: "{}", with output "{}")", launchOperationLog,
-                          output.exitCode, output.output);
+                          output.exitCode, loggedOutput(output.output));
 
             return ChefFun::Either<Error, Output>::Right(output);
         })
@@ -53,3 +161,476 @@ ChefFun::Either<SystemCommand::Error, SystemCommand::Output> SystemCommand::laun
             return ChefFun::Either<Error, Output>::Left(Error::LAUNCH_COMMAND);
         });
 }
+
+ChefFun::Either<SystemCommand::Error, std::shared_ptr<SystemCommand::Process>> SystemCommand::spawn() const
+{
+    return spawn(Capture{});
+}
+
+ChefFun::Either<SystemCommand::Error, std::shared_ptr<SystemCommand::Process>>
+SystemCommand::spawn(Capture capture) const
+{
+    using Result = ChefFun::Either<Error, std::shared_ptr<Process>>;
+    const std::string spawnOperationLog = fmt::format(R"(Spawned command: "{}".)", mCmd);
+
+#ifdef TARGET_OS_LINUX
+    // Commands given as a string still need a shell to be split
+    const std::vector<std::string> shell{"/bin/sh", "-c", mCmd};
+    std::vector<std::string> variables;
+    for (const auto& [name, value] : mEnvironment ? *mEnvironment : environment())
+    {
+        variables.emplace_back(fmt::format("{}={}", name, value));
+    }
+
+    // Spawned by the launcher helper when it is running: launch latency does not depend on how much memory we have
+    // mapped (see the spawn benchmark)
+    auto child = Launcher::spawn(mArguments.empty() ? shell : mArguments, variables);
+    if (child.isLeft())
+    {
+        spdlog::error(R"({} Operation failed, could not spawn: "{}")", spawnOperationLog,
+                      std::strerror(child.getLeft()));
+        return Result::Left(Error::LAUNCH_COMMAND);
+    }
+
+    const auto& spawned = child.getRight();
+    fcntl(spawned.outputFd, F_SETFL, fcntl(spawned.outputFd, F_GETFL) | O_NONBLOCK);
+
+    spdlog::debug("{} Running with pid {}", spawnOperationLog, spawned.pid);
+    return Result::Right(std::shared_ptr<Process>(
+        new Process(mCmd, std::move(capture), spawned.pid, spawned.outputFd, spawned.statusFd)));
+#elif defined(TARGET_OS_WINDOWS)
+    if (mEnvironment)
+    {
+        spdlog::warn("{} Custom environments are not supported on this platform, the current one is used",
+                     spawnOperationLog);
+    }
+
+    spdlog::debug("{} Running", spawnOperationLog);
+    return Result::Right(std::shared_ptr<Process>(
+        new Process(mCmd, std::move(capture), std::async(std::launch::async, runCommand, mCmd))));
+#else
+#error "Unknown target OS. Compilation halted."
+#endif
+}
+
+// Writes output to a file from its own thread, so a slow disk never stalls whoever polls the process
+class SystemCommand::Process::Spill
+{
+ private:
+    // If the disk can't keep up we drop output rather than growing without limits
+    static constexpr std::size_t MAX_PENDING = 1024 * 1024;
+
+    std::ofstream mFile;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::string mPending;
+    std::size_t mDropped = 0;
+    bool mStopping = false;
+    std::thread mThread;
+
+    void run()
+    {
+        std::string writing;
+        while (true)
+        {
+            {
+                std::unique_lock lock(mMutex);
+                mCondition.wait(lock, [this]() { return !mPending.empty() || mStopping; });
+                if (mPending.empty())
+                {
+                    return;
+                }
+
+                std::swap(writing, mPending);
+            }
+
+            mFile.write(writing.data(), static_cast<std::streamsize>(writing.size()));
+            mFile.flush();
+            writing.clear();
+        }
+    }
+
+ public:
+    inline explicit Spill(const std::filesystem::path& path)
+        : mFile(path, std::ios::binary | std::ios::trunc), mThread(&Spill::run, this)
+    {}
+
+    Spill(const Spill& spill) = delete;
+    Spill(Spill&& spill) = delete;
+
+    [[nodiscard]] inline bool good() const
+    {
+        return mFile.good();
+    }
+
+    void write(std::string_view chunk)
+    {
+        {
+            std::scoped_lock lock(mMutex);
+            if (mPending.size() + chunk.size() > MAX_PENDING)
+            {
+                mDropped += chunk.size();
+                return;
+            }
+
+            mPending.append(chunk);
+        }
+
+        mCondition.notify_one();
+    }
+
+    Spill& operator=(const Spill& spill) = delete;
+    Spill& operator=(Spill&& spill) = delete;
+
+    ~Spill()
+    {
+        {
+            std::scoped_lock lock(mMutex);
+            mStopping = true;
+        }
+
+        mCondition.notify_one();
+        mThread.join();
+
+        if (mDropped != 0)
+        {
+            spdlog::warn("{} bytes of output could not be written to the log file in time and were dropped", mDropped);
+        }
+    }
+};
+
+void SystemCommand::Process::consume(std::string_view chunk)
+{
+    mOutput.append(chunk);
+    if (mSpill)
+    {
+        mSpill->write(chunk);
+    }
+
+    if (!mOnLine)
+    {
+        return;
+    }
+
+    while (!chunk.empty())
+    {
+        auto newline = chunk.find('\n');
+        auto piece = chunk.substr(0, newline);
+
+        // Lines are cut at the capture limit, like the output itself
+        if (mLine.size() < mOutput.capacity())
+        {
+            mLine.append(piece.substr(0, mOutput.capacity() - mLine.size()));
+        }
+
+        if (newline == std::string_view::npos)
+        {
+            return;
+        }
+
+        mOnLine(mLine);
+        mLine.clear();
+        chunk.remove_prefix(newline + 1);
+    }
+}
+
+void SystemCommand::Process::openLog(const std::optional<std::filesystem::path>& logFile)
+{
+    if (!logFile)
+    {
+        return;
+    }
+
+    mSpill = std::make_unique<Spill>(*logFile);
+    if (!mSpill->good())
+    {
+        spdlog::warn(R"(Output of command "{}" can't be written to "{}")", mCmd, logFile->string());
+        mSpill.reset();
+    }
+}
+
+void SystemCommand::Process::flushLine()
+{
+    // Whatever the command wrote after its last newline
+    if (mOnLine && !mLine.empty())
+    {
+        mOnLine(mLine);
+    }
+
+    mLine.clear();
+}
+
+#ifdef TARGET_OS_LINUX
+namespace {
+// Same as waitpid() for a single command (without the EINTR hassle), commands spawned by the launcher helper are not
+// our children: their wait status is read from the descriptor the helper writes it to
+pid_t waitFor(const pid_t pid, const int statusFd, int& status, const bool blocking)
+{
+    if (statusFd < 0)
+    {
+        pid_t result = 0;
+        do
+        {
+            result = waitpid(pid, &status, blocking ? 0 : WNOHANG);
+        } while (result < 0 && errno == EINTR);
+
+        return result;
+    }
+
+    pollfd descriptor{.fd = statusFd, .events = POLLIN, .revents = 0};
+    if (!blocking && ::poll(&descriptor, 1, 0) == 0)
+    {
+        return 0;
+    }
+
+    ssize_t bytes = 0;
+    do
+    {
+        bytes = read(statusFd, &status, sizeof(status));
+    } while (bytes < 0 && errno == EINTR);
+
+    if (bytes != sizeof(status))
+    {
+        // The helper died before the command exited, nobody will ever tell us how it went
+        errno = ECHILD;
+        return -1;
+    }
+
+    return pid;
+}
+
+// Waits for a command which was asked to terminate and kills it if it does not comply in time
+void reapCancelled(const pid_t pid, const int statusFd, const std::string& cmd, const std::chrono::milliseconds timeout)
+{
+    static constexpr std::chrono::milliseconds CHECK_INTERVAL{10};
+
+    int status = 0;
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    auto result = waitFor(pid, statusFd, status, false);
+    while (result == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(CHECK_INTERVAL);
+        result = waitFor(pid, statusFd, status, false);
+    }
+
+    if (result == 0)
+    {
+        spdlog::warn(R"(Command "{}" did not terminate in {}ms, killing it)", cmd, timeout.count());
+        kill(-pid, SIGKILL);
+        std::ignore = waitFor(pid, statusFd, status, true);
+    }
+
+    if (statusFd >= 0)
+    {
+        close(statusFd);
+    }
+}
+} // namespace
+
+SystemCommand::Process::Process(const std::string& cmd, Capture&& capture, pid_t pid, int outputFd, int statusFd)
+    : mCmd(cmd), mOutput(capture.limit), mOnLine(std::move(capture.onLine)), mPid(pid), mOutputFd(outputFd),
+      mStatusFd(statusFd)
+{
+    openLog(capture.logFile);
+}
+
+void SystemCommand::Process::readOutput(bool untilEnd)
+{
+    std::array<char, 4096> buffer{}; // NOLINT
+    while (mOutputFd >= 0)
+    {
+        auto bytes = read(mOutputFd, buffer.data(), buffer.size());
+        if (bytes > 0)
+        {
+            consume(std::string_view(buffer.data(), static_cast<std::size_t>(bytes)));
+        }
+        else if (bytes < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            if (!untilEnd)
+            {
+                return;
+            }
+
+            pollfd descriptor{.fd = mOutputFd, .events = POLLIN, .revents = 0};
+            ::poll(&descriptor, 1, -1);
+        }
+        else
+        {
+            // End of output (or an error we can't do anything about)
+            close(mOutputFd);
+            mOutputFd = -1;
+            flushLine();
+        }
+    }
+}
+
+void SystemCommand::Process::reap(bool blocking)
+{
+    if (mExitCode)
+    {
+        return;
+    }
+
+    int status = 0;
+    const auto result = waitFor(mPid, mStatusFd, status, blocking);
+    if (result == mPid)
+    {
+        // Same convention as shells: a command killed by a signal exits with 128 + signal number
+        mExitCode = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status); // NOLINT
+        spdlog::debug(R"(Command "{}" exited with exit code: "{}")", mCmd, *mExitCode);
+    }
+    else if (result < 0)
+    {
+        spdlog::error(R"(Command "{}" could not be waited on: "{}")", mCmd, std::strerror(errno));
+        mExitCode = -1;
+    }
+}
+
+std::optional<SystemCommand::Output> SystemCommand::Process::poll()
+{
+    readOutput(false);
+    reap(false);
+    if (running())
+    {
+        return std::nullopt;
+    }
+
+    // Whatever the command wrote right before exiting
+    readOutput(false);
+    return Output{*mExitCode, mOutput.str()};
+}
+
+SystemCommand::Output SystemCommand::Process::wait()
+{
+    readOutput(true);
+    reap(true);
+    return Output{*mExitCode, mOutput.str()};
+}
+
+bool SystemCommand::Process::cancel(std::chrono::milliseconds timeout)
+{
+    static constexpr std::chrono::milliseconds CHECK_INTERVAL{10};
+
+    if (!running())
+    {
+        return true;
+    }
+
+    spdlog::debug(R"(Cancelling command "{}")", mCmd);
+    kill(-mPid, SIGTERM);
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (poll())
+        {
+            return true;
+        }
+
+        std::this_thread::sleep_for(CHECK_INTERVAL);
+    }
+
+    spdlog::warn(R"(Command "{}" did not terminate in {}ms, killing it)", mCmd, timeout.count());
+    kill(-mPid, SIGKILL);
+    reap(true);
+    readOutput(false);
+    return false;
+}
+
+SystemCommand::Process::~Process()
+{
+    // Nobody reads the output anymore, a command still writing gets an error instead of filling the pipe up
+    if (mOutputFd >= 0)
+    {
+        close(mOutputFd);
+    }
+
+    if (running())
+    {
+        // Destruction never blocks (it may well happen on the GUI thread): the command is asked to terminate right
+        // away, waiting for it and killing it if needed is left to a thread of its own. Owners who need the command
+        // gone before moving on call cancel() instead
+        spdlog::debug(R"(Cancelling command "{}" in background)", mCmd);
+        kill(-mPid, SIGTERM);
+        std::thread(reapCancelled, mPid, mStatusFd, mCmd, DEFAULT_CANCEL_TIMEOUT).detach();
+    }
+    else if (mStatusFd >= 0)
+    {
+        close(mStatusFd);
+    }
+}
+#elif defined(TARGET_OS_WINDOWS)
+SystemCommand::Process::Process(const std::string& cmd, Capture&& capture,
+                                std::future<ChefFun::Either<SYSTEM2_RESULT, Output>>&& result)
+    : mCmd(cmd), mOutput(capture.limit), mOnLine(std::move(capture.onLine)), mResult(std::move(result))
+{
+    openLog(capture.logFile);
+}
+
+void SystemCommand::Process::collect()
+{
+    if (!running() || !mResult.valid())
+    {
+        return;
+    }
+
+    auto result = mResult.get();
+    if (result.isLeft())
+    {
+        spdlog::error(R"(Command "{}" failed, underlying subprocess library reported error: "{}")", mCmd,
+                      magic_enum::enum_name(result.getLeft()));
+        mExitCode = -1;
+        return;
+    }
+
+    // Output is only available once the command is over
+    consume(result.getRight().output);
+    flushLine();
+    mExitCode = result.getRight().exitCode;
+
+    spdlog::debug(R"(Command "{}" exited with exit code: "{}")", mCmd, *mExitCode);
+}
+
+std::optional<SystemCommand::Output> SystemCommand::Process::poll()
+{
+    if (running() && mResult.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        collect();
+    }
+
+    return running() ? std::nullopt : std::optional<Output>(Output{*mExitCode, mOutput.str()});
+}
+
+SystemCommand::Output SystemCommand::Process::wait()
+{
+    collect();
+    return Output{*mExitCode, mOutput.str()};
+}
+
+bool SystemCommand::Process::cancel(std::chrono::milliseconds timeout)
+{
+    if (!running())
+    {
+        return true;
+    }
+
+    // System2 gives us no handle to terminate the command, the best we can do is giving it some time to finish
+    spdlog::warn(R"(Command "{}" can't be cancelled on this platform, waiting up to {}ms for it)", mCmd,
+                 timeout.count());
+    if (mResult.wait_for(timeout) == std::future_status::ready)
+    {
+        collect();
+        return true;
+    }
+
+    return false;
+}
+
+SystemCommand::Process::~Process() = default;
+#else
+#error "Unknown target OS. Compilation halted."
+#endif
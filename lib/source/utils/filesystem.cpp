@@ -0,0 +1,76 @@
+#include "utils/filesystem.hpp"
+
+#ifdef TARGET_OS_LINUX
+#include <cstring>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#ifdef TARGET_OS_LINUX
+std::vector<std::filesystem::path> utils::filesystem::posixFileList(const std::filesystem::path& folder)
+{
+    std::vector<std::filesystem::path> result;
+
+    DIR* dp;
+    struct dirent* entry;
+    struct stat info;
+
+    if ((dp = opendir(folder.c_str())) == NULL)
+    {
+        return result;
+    }
+
+    while ((entry = readdir(dp)) != NULL)
+    {
+        std::filesystem::path path = folder / entry->d_name;
+
+        if (stat(path.c_str(), &info) != 0)
+        {
+            continue;
+        }
+
+        if (S_ISDIR(info.st_mode))
+        {
+            // Skip "." and ".." directories
+            if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+            {
+                // Recurse into subdirectories
+                std::vector<std::filesystem::path> subDirFiles = posixFileList(path);
+                result.insert(result.end(), subDirFiles.begin(), subDirFiles.end());
+            }
+        }
+        else
+        {
+            // It's a file, add to list
+            result.push_back(path);
+        }
+    }
+
+    closedir(dp);
+
+    return result;
+}
+#endif
+
+#ifndef USE_POSIX_FILE_LIST
+std::vector<std::filesystem::path> utils::filesystem::stdFileList(const std::filesystem::path& folder)
+{
+    std::vector<std::filesystem::path> result;
+
+    try
+    {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(folder))
+        {
+            result.push_back(std::filesystem::absolute(entry.path()));
+        }
+    }
+    catch (const std::filesystem::filesystem_error&)
+    {
+        return std::vector<std::filesystem::path>();
+    }
+
+    return result;
+}
+#endif
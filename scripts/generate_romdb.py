@@ -29,7 +29,10 @@ roms = {
     'values': games
 }
 
-for game in root.findall('game'):
+# Clones are looked up by name to find the bios of their parent
+games_by_name = {game.get('name'): game for game in root.findall('game')}
+
+for game in games_by_name.values():
     game_data = {
         'key': game.get('name'),
         'info': {
@@ -58,6 +61,34 @@ for game in root.findall('game'):
     else:
         game_data['info']['isBios'] = False
 
+    # Finding the sets MAME also needs to run this one: the parent of a clone and the bios of the whole family
+    cloneof = game.get('cloneof')
+    if cloneof is not None:
+        game_data['info']['parent'] = cloneof
+    romof = game.get('romof')
+    if romof is not None and romof != cloneof:
+        game_data['info']['bios'] = romof
+    elif cloneof is not None:
+        parent_element = games_by_name.get(cloneof)
+        if parent_element is not None and parent_element.get('romof') is not None:
+            game_data['info']['bios'] = parent_element.get('romof')
+
+    # Listing the files the rom archive is expected to contain, so romsets can be audited
+    # Files merged from a parent or bios set are not stored in this archive and files without a dump can't be checked
+    files = []
+    for rom_element in game.findall('rom'):
+        if rom_element.get('merge') is not None or rom_element.get('status') == 'nodump':
+            continue
+        if rom_element.get('crc') is None or rom_element.get('size') is None:
+            continue
+        files.append({
+            'name': rom_element.get('name'),
+            'size': int(rom_element.get('size')),
+            'crc': int(rom_element.get('crc'), 16)
+        })
+    if files:
+        game_data['info']['files'] = files
+
     games.append(game_data)
 
 # Write the JSON output to a file
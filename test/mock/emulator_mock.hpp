@@ -10,8 +10,13 @@ class EmulatorMock : public Emulator
  public:
     using Emulator::Emulator;
 
-    MOCK_METHOD((ChefFun::Either<SystemCommand::Error, SystemCommand::Output>), launch, (const std::string& arguments),
-                (const override));
+    MOCK_METHOD((ChefFun::Either<SystemCommand::Error, SystemCommand::Output>), launch,
+                (const std::vector<std::string>& arguments), (const override));
+    MOCK_METHOD((ChefFun::Either<SystemCommand::Error, SystemCommand::Output>), launchHeadless,
+                (const std::vector<std::string>& arguments, std::chrono::milliseconds timeout), (const override));
+    MOCK_METHOD((ChefFun::Either<SystemCommand::Error, std::shared_ptr<SystemCommand::Process>>), spawn,
+                (const std::vector<std::string>& arguments), (const override));
+    MOCK_METHOD(std::optional<Emulator::Fingerprint>, fingerprint, (), (const override));
     MOCK_METHOD(bool, romExists, (const Rom::Game& rom), (const override));
     MOCK_METHOD(bool, romIsReadable, (const Rom::Game& rom), (const override));
 };
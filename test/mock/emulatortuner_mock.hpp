@@ -0,0 +1,17 @@
+#ifndef EMULATORTUNERMOCK_HPP
+#define EMULATORTUNERMOCK_HPP
+
+#include <gmock/gmock.h>
+
+#include "emulatortuner.hpp"
+
+class EmulatorTunerMock : public EmulatorTuner
+{
+ public:
+    using EmulatorTuner::EmulatorTuner;
+
+    MOCK_METHOD(EmulatorTuner::Hardware, hardware, (), (const override));
+    MOCK_METHOD(EmulatorTuner::Calibration, calibrate, (), (const override));
+};
+
+#endif // EMULATORTUNERMOCK_HPP
@@ -11,7 +11,9 @@ class SourceMock : public Source
  public:
     using Source::Source;
     MOCK_METHOD(std::vector<std::filesystem::path>, scan, (), (const override));
-    MOCK_METHOD(std::optional<Rom::Info>, romInfo, (const std::filesystem::path& path), (const override));
+    MOCK_METHOD(std::optional<Rom::Definition>, definition, (const std::filesystem::path& path), (const override));
+    MOCK_METHOD(Rom::Audit, audit, (const std::filesystem::path& path, const Rom::Definition& definition),
+                (const override));
     MOCK_METHOD(std::optional<std::string>, lastModified, (), (const override));
     MOCK_METHOD(bool, writeCacheFile, (const nlohmann::json& json, const std::filesystem::path& path),
                 (const override));
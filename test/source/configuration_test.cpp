@@ -103,3 +103,63 @@ TEST(Configuration, advMameConfigurationFileNoHome)
 
     EXPECT_THROW(config.advMameConfigurationFile(), ConfigurationMock::Exception);
 }
+
+/*
+    Asking for the file the emulator output is logged to.
+    Expectation: we get a file name constructed with home + .enea + advmame.log
+*/
+TEST(Configuration, emulatorLogFile)
+{
+    ConfigurationMock config;
+    EXPECT_CALL(config, homeDirectory()).WillOnce(testing::Return(home));
+
+    EXPECT_EQ(config.emulatorLogFile(), base / "advmame.log");
+}
+
+/*
+    Asking for the file the scheduling policy is read from.
+    Expectation: we get a file name constructed with home + .enea + scheduling.json
+*/
+TEST(Configuration, schedulingPolicyFile)
+{
+    ConfigurationMock config;
+    EXPECT_CALL(config, homeDirectory()).WillOnce(testing::Return(home));
+
+    EXPECT_EQ(config.schedulingPolicyFile(), base / "scheduling.json");
+}
+
+/*
+    Asking for the file benchmark results are cached in.
+    Expectation: we get a file name constructed with home + .enea + cache + benchmarks.json
+*/
+TEST(Configuration, benchmarkFile)
+{
+    ConfigurationMock config;
+    EXPECT_CALL(config, homeDirectory()).WillOnce(testing::Return(home));
+
+    EXPECT_EQ(config.benchmarkFile(), base / "cache" / "benchmarks.json");
+}
+
+/*
+    Asking for the file the hardware the emulator was tuned for is cached in.
+    Expectation: we get a file name constructed with home + .enea + cache + hardware.json
+*/
+TEST(Configuration, hardwareFile)
+{
+    ConfigurationMock config;
+    EXPECT_CALL(config, homeDirectory()).WillOnce(testing::Return(home));
+
+    EXPECT_EQ(config.hardwareFile(), base / "cache" / "hardware.json");
+}
+
+/*
+    Asking for the file launch latency histograms are kept in.
+    Expectation: we get a file name constructed with home + .enea + launch_latency.json
+*/
+TEST(Configuration, launchHistogramFile)
+{
+    ConfigurationMock config;
+    EXPECT_CALL(config, homeDirectory()).WillOnce(testing::Return(home));
+
+    EXPECT_EQ(config.launchHistogramFile(), base / "launch_latency.json");
+}
@@ -1,7 +1,9 @@
 #include "emulator_mock.hpp"
 
+#include <chrono>
 #include <fmt/format.h>
 #include <gtest/gtest.h>
+#include <sstream>
 #include <utility>
 
 #include "input/device.hpp"
@@ -25,10 +27,17 @@ static const std::string INPUT_STRING =
     "keyboard[0,l] -input_map[coin2] keyboard[0,4] -input_map[start2] keyboard[0,2] -input_map[ui_pause] keyboard[0,9] "
     "-input_map[ui_cancel] keyboard[0,esc]";
 
-static const std::string LAUNCH_COMMAND =
-    fmt::format("-misc_quiet -nomisc_safequit --device_video sdl --device_keyboard sdl --device_joystick sdl {} "
-                "-dir_rom {} {}",
-                INPUT_STRING, ROM_PATH.parent_path().string(), ROM_PATH.stem().string());
+static const std::vector<std::string> LAUNCH_COMMAND = []() {
+    std::vector<std::string> result{"-misc_quiet", "-nomisc_safequit", "--device_video",    "sdl",
+                                    "--device_keyboard", "sdl",          "--device_joystick", "sdl"};
+    std::istringstream options(INPUT_STRING);
+    for (std::string option; options >> option;)
+    {
+        result.push_back(option);
+    }
+    result.insert(result.end(), {"-dir_rom", ROM_PATH.parent_path().string(), ROM_PATH.stem().string()});
+    return result;
+}();
 
 class EmulatorFixture : public ::testing::Test
 {
@@ -40,7 +49,7 @@ class EmulatorFixture : public ::testing::Test
 
 TEST_F(EmulatorFixture, info)
 {
-    EXPECT_CALL(emulator, launch("-version"))
+    EXPECT_CALL(emulator, launch(std::vector<std::string>{"-version"}))
         .WillOnce(testing::Return(ChefFun::Either<SystemCommand::Error, SystemCommand::Output>::Right(
             SystemCommand::Output{0, EMULATOR_VERSION_OUTPUT})));
     auto info = emulator.info();
@@ -51,7 +60,7 @@ TEST_F(EmulatorFixture, info)
 
 TEST_F(EmulatorFixture, infoEmulatorCallFails)
 {
-    EXPECT_CALL(emulator, launch("-version"))
+    EXPECT_CALL(emulator, launch(std::vector<std::string>{"-version"}))
         .WillOnce(testing::Return(ChefFun::Either<SystemCommand::Error, SystemCommand::Output>::Right(
             SystemCommand::Output{1, EMULATOR_VERSION_OUTPUT})));
     auto info = emulator.info();
@@ -60,7 +69,7 @@ TEST_F(EmulatorFixture, infoEmulatorCallFails)
 
 TEST_F(EmulatorFixture, infoEmulatorUnexpectedOutput)
 {
-    EXPECT_CALL(emulator, launch("-version"))
+    EXPECT_CALL(emulator, launch(std::vector<std::string>{"-version"}))
         .WillOnce(testing::Return(ChefFun::Either<SystemCommand::Error, SystemCommand::Output>::Right(
             SystemCommand::Output{0, EMULATOR_VERSION_UNEXPECTED_OUTPUT})));
     auto info = emulator.info();
@@ -119,3 +128,205 @@ TEST_F(EmulatorFixture, DISABLED_runEmulatorError)
     ASSERT_TRUE(runError.has_value());
     EXPECT_EQ(*(runError), Emulator::Error::EMULATOR_ERROR);
 }
+
+/*
+    Starting a rom which does not exist
+    Expectation: the error is reported and the emulator is never spawned
+*/
+TEST_F(EmulatorFixture, startRomNonExistant)
+{
+    EXPECT_CALL(emulator, romExists(rom)).WillOnce(testing::Return(false));
+    EXPECT_CALL(emulator, spawn(testing::_)).Times(0);
+
+    auto started = emulator.start(rom, INPUT_STRING);
+    ASSERT_TRUE(started.isLeft());
+    EXPECT_EQ(started.getLeft(), Emulator::Error::ROM_FILE_NOT_FOUND);
+}
+
+/*
+    Starting a rom without any input available
+    Expectation: the error is reported and the emulator is never spawned
+*/
+TEST_F(EmulatorFixture, startNoInput)
+{
+    EXPECT_CALL(emulator, romExists(rom)).WillOnce(testing::Return(true));
+    EXPECT_CALL(emulator, romIsReadable(rom)).WillOnce(testing::Return(true));
+    EXPECT_CALL(emulator, spawn(testing::_)).Times(0);
+
+    auto started = emulator.start(rom, "");
+    ASSERT_TRUE(started.isLeft());
+    EXPECT_EQ(started.getLeft(), Emulator::Error::NO_VALID_INPUT);
+}
+
+class EmulatorCacheFixture : public EmulatorFixture
+{
+ protected:
+    const std::filesystem::path cacheFile = std::filesystem::temp_directory_path() / "enea_emulator_test.json";
+    const Emulator::Fingerprint binary{.path = "/usr/bin/advmame", .size = 1024, .lastModified = 1};
+
+    void SetUp() override
+    {
+        std::filesystem::remove(cacheFile);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(cacheFile);
+    }
+};
+
+/*
+    Retrieving emulator info twice with the same emulator binary
+    Expectation: the emulator is probed only the first time, the second time the cached info is ready right away
+*/
+TEST_F(EmulatorCacheFixture, infoCached)
+{
+    EXPECT_CALL(emulator, fingerprint()).WillRepeatedly(testing::Return(binary));
+    EXPECT_CALL(emulator, launch(std::vector<std::string>{"-version"}))
+        .WillOnce(testing::Return(ChefFun::Either<SystemCommand::Error, SystemCommand::Output>::Right(
+            SystemCommand::Output{0, EMULATOR_VERSION_OUTPUT})));
+
+    auto info = emulator.info(cacheFile).get();
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->version, EMULATOR_VERSION);
+
+    auto cachedInfo = emulator.info(cacheFile);
+    ASSERT_EQ(cachedInfo.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(cachedInfo.get(), info);
+}
+
+/*
+    Retrieving emulator info after the emulator binary changed
+    Expectation: the emulator is probed again
+*/
+TEST_F(EmulatorCacheFixture, infoBinaryChanged)
+{
+    auto updatedBinary = binary;
+    updatedBinary.lastModified++;
+
+    EXPECT_CALL(emulator, fingerprint()).WillOnce(testing::Return(binary)).WillOnce(testing::Return(updatedBinary));
+    EXPECT_CALL(emulator, launch(std::vector<std::string>{"-version"}))
+        .Times(2)
+        .WillRepeatedly(testing::Return(ChefFun::Either<SystemCommand::Error, SystemCommand::Output>::Right(
+            SystemCommand::Output{0, EMULATOR_VERSION_OUTPUT})));
+
+    EXPECT_TRUE(emulator.info(cacheFile).get().has_value());
+    EXPECT_TRUE(emulator.info(cacheFile).get().has_value());
+}
+
+/*
+    Retrieving emulator info when no emulator binary is available
+    Expectation: nothing is returned right away and the emulator is never launched
+*/
+TEST_F(EmulatorCacheFixture, infoNoBinary)
+{
+    EXPECT_CALL(emulator, fingerprint()).WillOnce(testing::Return(std::nullopt));
+    EXPECT_CALL(emulator, launch(testing::_)).Times(0);
+
+    auto info = emulator.info(cacheFile);
+    ASSERT_EQ(info.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_FALSE(info.get().has_value());
+}
+
+/*
+    Benchmarking a rom with an emulator which reports its speed
+    Expectation: the emulator runs the rom for the requested time, it is given twice that to finish and its reported
+    speed is returned
+*/
+TEST_F(EmulatorFixture, benchmark)
+{
+    EXPECT_CALL(emulator, romExists(rom)).WillOnce(testing::Return(true));
+    EXPECT_CALL(emulator, romIsReadable(rom)).WillOnce(testing::Return(true));
+    EXPECT_CALL(emulator, launchHeadless(testing::AllOf(testing::Contains("-misc_timetorun"), testing::Contains("5"),
+                                                        testing::Contains(ROM_PATH.stem().string())),
+                                         std::chrono::milliseconds(std::chrono::seconds(10))))
+        .WillOnce(testing::Return(ChefFun::Either<SystemCommand::Error, SystemCommand::Output>::Right(
+            SystemCommand::Output{0, "Loading sf2\nAverage speed: 87.50% (5 seconds)\n"})));
+
+    auto benchmark = emulator.benchmark(rom, 5);
+    ASSERT_TRUE(benchmark.isRight());
+    EXPECT_EQ(benchmark.getRight(), (Emulator::Benchmark{.speed = 87.5, .seconds = 5}));
+    EXPECT_FALSE(benchmark.getRight().fullSpeed());
+}
+
+/*
+    Benchmarking a rom with an emulator which does not report its speed
+    Expectation: the speed is computed from how long the run took, an instant run is way faster than full speed
+*/
+TEST_F(EmulatorFixture, benchmarkNoReportedSpeed)
+{
+    EXPECT_CALL(emulator, romExists(rom)).WillOnce(testing::Return(true));
+    EXPECT_CALL(emulator, romIsReadable(rom)).WillOnce(testing::Return(true));
+    EXPECT_CALL(emulator, launchHeadless(testing::_, testing::_))
+        .WillOnce(testing::Return(
+            ChefFun::Either<SystemCommand::Error, SystemCommand::Output>::Right(SystemCommand::Output{0, ""})));
+
+    auto benchmark = emulator.benchmark(rom);
+    ASSERT_TRUE(benchmark.isRight());
+    EXPECT_TRUE(benchmark.getRight().fullSpeed());
+}
+
+/*
+    Benchmarking a rom the emulator fails to run
+    Expectation: the error is reported
+*/
+TEST_F(EmulatorFixture, benchmarkEmulatorError)
+{
+    EXPECT_CALL(emulator, romExists(rom)).WillOnce(testing::Return(true));
+    EXPECT_CALL(emulator, romIsReadable(rom)).WillOnce(testing::Return(true));
+    EXPECT_CALL(emulator, launchHeadless(testing::_, testing::_))
+        .WillOnce(testing::Return(
+            ChefFun::Either<SystemCommand::Error, SystemCommand::Output>::Right(SystemCommand::Output{1, ""})));
+
+    auto benchmark = emulator.benchmark(rom);
+    ASSERT_TRUE(benchmark.isLeft());
+    EXPECT_EQ(benchmark.getLeft(), Emulator::Error::EMULATOR_ERROR);
+}
+
+/*
+    Benchmarking a rom the emulator does not finish running in time
+    Expectation: the error is reported
+*/
+TEST_F(EmulatorFixture, benchmarkTimeout)
+{
+    EXPECT_CALL(emulator, romExists(rom)).WillOnce(testing::Return(true));
+    EXPECT_CALL(emulator, romIsReadable(rom)).WillOnce(testing::Return(true));
+    EXPECT_CALL(emulator, launchHeadless(testing::_, testing::_))
+        .WillOnce(testing::Return(
+            ChefFun::Either<SystemCommand::Error, SystemCommand::Output>::Left(SystemCommand::Error::LAUNCH_COMMAND)));
+
+    auto benchmark = emulator.benchmark(rom);
+    ASSERT_TRUE(benchmark.isLeft());
+    EXPECT_EQ(benchmark.getLeft(), Emulator::Error::EMULATOR_ERROR);
+}
+
+/*
+    Benchmarking a library twice with the same emulator binary, then once more after the binary changed
+    Expectation: bios are skipped, roms are run the first time only and again once the binary changed
+*/
+TEST_F(EmulatorCacheFixture, benchmarkLibrary)
+{
+    Rom::Library library(std::vector<Rom::Game>{
+        Rom::Game(ROM_PATH, Rom::Info{.title{"Street Fighter II"}, .isBios{false}}),
+        Rom::Game(std::filesystem::absolute("neogeo.zip"), Rom::Info{.title{"Neo Geo"}, .isBios{true}})});
+    auto updatedBinary = binary;
+    updatedBinary.lastModified++;
+
+    EXPECT_CALL(emulator, fingerprint())
+        .WillOnce(testing::Return(binary))
+        .WillOnce(testing::Return(binary))
+        .WillOnce(testing::Return(binary))
+        .WillOnce(testing::Return(binary))
+        .WillRepeatedly(testing::Return(updatedBinary));
+    EXPECT_CALL(emulator, romExists(testing::_)).WillRepeatedly(testing::Return(true));
+    EXPECT_CALL(emulator, romIsReadable(testing::_)).WillRepeatedly(testing::Return(true));
+    EXPECT_CALL(emulator, launchHeadless(testing::_, testing::_))
+        .Times(2)
+        .WillRepeatedly(testing::Return(ChefFun::Either<SystemCommand::Error, SystemCommand::Output>::Right(
+            SystemCommand::Output{0, "Average speed: 150.00% (10 seconds)"})));
+
+    auto expected = Emulator::Benchmarks{{ROM_PATH.stem().string(), Emulator::Benchmark{.speed = 150, .seconds = 10}}};
+    EXPECT_EQ(emulator.benchmark(library, cacheFile), expected);
+    EXPECT_EQ(emulator.benchmark(library, cacheFile), expected);
+    EXPECT_EQ(emulator.benchmark(library, cacheFile), expected);
+}
@@ -0,0 +1,119 @@
+#include "emulatortuner_mock.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+static const EmulatorTuner::Hardware RASPBERRY_PI{.cores = 4,
+                                                  .memory = 1024ULL * 1024 * 1024,
+                                                  .model = "Raspberry Pi 3 Model B Rev 1.2",
+                                                  .videoModes = {{.width = 640, .height = 480},
+                                                                 {.width = 1920, .height = 1080}}};
+static const EmulatorTuner::Calibration SLOW_CALIBRATION{.coreSpeed = 250,
+                                                         .timerJitter = std::chrono::microseconds(1500)};
+static const EmulatorTuner::Calibration FAST_CALIBRATION{.coreSpeed = 1500,
+                                                         .timerJitter = std::chrono::microseconds(80)};
+
+class EmulatorTunerFixture : public ::testing::Test
+{
+ protected:
+    EmulatorTunerMock tuner;
+    const std::filesystem::path base = std::filesystem::temp_directory_path() / "enea_emulatortuner_test";
+    const std::filesystem::path configurationFile = base / "advmame.rc";
+    const std::filesystem::path cacheFile = base / "hardware.json";
+
+    void SetUp() override
+    {
+        std::filesystem::remove_all(base);
+        std::filesystem::create_directories(base);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(base);
+    }
+};
+
+/*
+    Generating a configuration for a slow board.
+    Expectation: frames are skipped as needed, costly effects are off and the audio buffer is deep.
+*/
+TEST(EmulatorTuner, configurationSlow)
+{
+    auto configuration = EmulatorTuner::configuration(RASPBERRY_PI, SLOW_CALIBRATION);
+
+    EXPECT_TRUE(configuration.starts_with("# Generated by Enea for Raspberry Pi 3 Model B Rev 1.2"));
+    EXPECT_NE(configuration.find("misc_smp yes\n"), std::string::npos);
+    EXPECT_NE(configuration.find("display_frameskip auto\n"), std::string::npos);
+    EXPECT_NE(configuration.find("display_resizeeffect none\n"), std::string::npos);
+    EXPECT_NE(configuration.find("display_resize integer\n"), std::string::npos);
+    EXPECT_NE(configuration.find("sound_latency 0.10\n"), std::string::npos);
+}
+
+/*
+    Generating a configuration for a fast machine with a small display.
+    Expectation: every frame is shown, the audio buffer is shallow and scaling is not limited to integer factors.
+*/
+TEST(EmulatorTuner, configurationFast)
+{
+    auto hardware = RASPBERRY_PI;
+    hardware.videoModes = {{.width = 800, .height = 600}};
+    auto configuration = EmulatorTuner::configuration(hardware, FAST_CALIBRATION);
+
+    EXPECT_NE(configuration.find("display_frameskip 1.0\n"), std::string::npos);
+    EXPECT_NE(configuration.find("display_vsync yes\n"), std::string::npos);
+    EXPECT_NE(configuration.find("display_resize mixed\n"), std::string::npos);
+    EXPECT_NE(configuration.find("sound_latency 0.03\n"), std::string::npos);
+}
+
+/*
+    Tuning twice on the same hardware, then once more after the hardware changed.
+    Expectation: the configuration is generated the first time, left alone the second and generated again the third.
+*/
+TEST_F(EmulatorTunerFixture, tune)
+{
+    auto otherBoard = RASPBERRY_PI;
+    otherBoard.model = "Raspberry Pi 4 Model B Rev 1.4";
+
+    EXPECT_CALL(tuner, hardware())
+        .WillOnce(testing::Return(RASPBERRY_PI))
+        .WillOnce(testing::Return(RASPBERRY_PI))
+        .WillOnce(testing::Return(otherBoard));
+    EXPECT_CALL(tuner, calibrate()).Times(2).WillRepeatedly(testing::Return(SLOW_CALIBRATION));
+
+    EXPECT_TRUE(tuner.tune(configurationFile, cacheFile));
+    EXPECT_TRUE(std::filesystem::exists(configurationFile));
+    EXPECT_FALSE(tuner.tune(configurationFile, cacheFile));
+    EXPECT_TRUE(tuner.tune(configurationFile, cacheFile));
+}
+
+/*
+    Tuning when the configuration file was written by hand.
+    Expectation: the file is left untouched and no calibration is run.
+*/
+TEST_F(EmulatorTunerFixture, tuneHandWritten)
+{
+    std::ofstream(configurationFile) << "display_resize none\n";
+    EXPECT_CALL(tuner, calibrate()).Times(0);
+
+    EXPECT_FALSE(tuner.tune(configurationFile, cacheFile));
+
+    std::ifstream file(configurationFile);
+    std::string content(std::istreambuf_iterator<char>(file), {});
+    EXPECT_EQ(content, "display_resize none\n");
+}
+
+/*
+    Tuning after the generated configuration file was deleted, on the same hardware.
+    Expectation: the configuration is generated again.
+*/
+TEST_F(EmulatorTunerFixture, tuneDeleted)
+{
+    EXPECT_CALL(tuner, hardware()).WillRepeatedly(testing::Return(RASPBERRY_PI));
+    EXPECT_CALL(tuner, calibrate()).Times(2).WillRepeatedly(testing::Return(FAST_CALIBRATION));
+
+    EXPECT_TRUE(tuner.tune(configurationFile, cacheFile));
+    std::filesystem::remove(configurationFile);
+    EXPECT_TRUE(tuner.tune(configurationFile, cacheFile));
+}
@@ -0,0 +1,100 @@
+#include "imageloader.hpp"
+
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+static const std::filesystem::path SCREENSHOT = "snap/aof.png";
+
+// Declared before the loader, so it outlives the workers calling it
+using DecoderMock = testing::MockFunction<std::unique_ptr<sf::Image>(const std::filesystem::path& path)>;
+
+// Decoding happens in background, results are waited for a reasonable amount of time
+static std::vector<ImageLoader::Image> collect(ImageLoader& loader, std::size_t count)
+{
+    std::vector<ImageLoader::Image> result;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (result.size() < count && std::chrono::steady_clock::now() < deadline)
+    {
+        for (auto& image : loader.collect())
+        {
+            result.push_back(std::move(image));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return result;
+}
+
+/*
+    Loading an image.
+    Expectation: the decoded image is collected.
+*/
+TEST(ImageLoader, load)
+{
+    DecoderMock decode;
+    EXPECT_CALL(decode, Call(SCREENSHOT)).WillOnce([](const auto&) { return std::make_unique<sf::Image>(); });
+    ImageLoader loader(decode.AsStdFunction());
+
+    loader.load(SCREENSHOT);
+    auto images = collect(loader, 1);
+    ASSERT_EQ(images.size(), 1);
+    EXPECT_EQ(images[0].path, SCREENSHOT);
+    EXPECT_NE(images[0].image, nullptr);
+}
+
+/*
+    Loading an image which can't be decoded.
+    Expectation: an empty image is collected.
+*/
+TEST(ImageLoader, loadInvalid)
+{
+    DecoderMock decode;
+    EXPECT_CALL(decode, Call(SCREENSHOT)).WillOnce([](const auto&) { return nullptr; });
+    ImageLoader loader(decode.AsStdFunction());
+
+    loader.load(SCREENSHOT);
+    auto images = collect(loader, 1);
+    ASSERT_EQ(images.size(), 1);
+    EXPECT_EQ(images[0].path, SCREENSHOT);
+    EXPECT_EQ(images[0].image, nullptr);
+}
+
+/*
+    Loading again an image which was being decoded when loading was cancelled.
+    Expectation: the image is decoded again rather than waited for, and only the second decode is collected.
+*/
+TEST(ImageLoader, loadAfterCancel)
+{
+    DecoderMock decode;
+    std::promise<void> started;
+    std::promise<void> release;
+    std::promise<void> finished;
+    EXPECT_CALL(decode, Call(SCREENSHOT))
+        .WillOnce([&started, released = release.get_future().share(), &finished](const auto&) {
+            started.set_value();
+            released.wait();
+            finished.set_value();
+            return std::make_unique<sf::Image>();
+        })
+        .WillOnce([](const auto&) { return std::make_unique<sf::Image>(); });
+    ImageLoader loader(decode.AsStdFunction());
+
+    loader.load(SCREENSHOT);
+    started.get_future().wait();
+    loader.cancel();
+    loader.load(SCREENSHOT);
+
+    auto images = collect(loader, 1);
+    ASSERT_EQ(images.size(), 1);
+    EXPECT_EQ(images[0].path, SCREENSHOT);
+
+    // The decode requested before cancelling is thrown away
+    release.set_value();
+    finished.get_future().wait();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_TRUE(loader.collect().empty());
+}
@@ -0,0 +1,78 @@
+#include "launcher.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "systemcommand.hpp"
+
+#ifdef TARGET_OS_LINUX
+#include <cerrno>
+#include <unistd.h>
+
+/*
+    Launching a command while the launcher helper is running
+    Expectation: the command is not our child but its output and exit code reach us all the same
+*/
+TEST(Launcher, launch)
+{
+    ASSERT_TRUE(Launcher::start());
+    ASSERT_TRUE(Launcher::running());
+
+    auto result = SystemCommand(std::vector<std::string>{"sh", "-c", "echo $PPID; exit 3"}).launch();
+    ASSERT_TRUE(result.isRight());
+    EXPECT_EQ(result.getRight().exitCode, 3);
+    EXPECT_NE(result.getRight().output, std::to_string(getpid()) + "\n");
+}
+
+/*
+    Launching a command with an explicit environment through the launcher helper
+    Expectation: the command sees exactly the given variables
+*/
+TEST(Launcher, environment)
+{
+    ASSERT_TRUE(Launcher::start());
+
+    auto process =
+        SystemCommand(std::vector<std::string>{"env"}, SystemCommand::Environment{{"ENEA_TEST", "enea"}}).spawn();
+    ASSERT_TRUE(process.isRight());
+    EXPECT_EQ(process.getRight()->wait().output, "ENEA_TEST=enea\n");
+}
+
+/*
+    Cancelling a command spawned by the launcher helper
+    Expectation: the command terminates well before it would have finished on its own
+*/
+TEST(Launcher, cancel)
+{
+    ASSERT_TRUE(Launcher::start());
+
+    auto process = SystemCommand("sleep 10").spawn();
+    ASSERT_TRUE(process.isRight());
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(process.getRight()->cancel());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    EXPECT_FALSE(process.getRight()->running());
+}
+
+/*
+    Asking the launcher helper for a command which does not exist
+    Expectation: the error is reported and the helper keeps serving requests
+*/
+TEST(Launcher, spawnNonExistant)
+{
+    ASSERT_TRUE(Launcher::start());
+
+    auto child = Launcher::spawn({"enea_command_which_does_not_exist"}, {});
+    ASSERT_TRUE(child.isLeft());
+    EXPECT_EQ(child.getLeft(), ENOENT);
+
+    auto result = SystemCommand(std::vector<std::string>{"true"}).launch();
+    ASSERT_TRUE(result.isRight());
+    EXPECT_EQ(result.getRight().exitCode, 0);
+    EXPECT_TRUE(Launcher::running());
+}
+#endif
@@ -0,0 +1,106 @@
+#include "launchtimeline.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+using namespace std::chrono_literals;
+
+class LaunchTimelineFixture : public ::testing::Test
+{
+ protected:
+    const std::filesystem::path histogramFile = std::filesystem::temp_directory_path() / "enea_launch_test.json";
+    LaunchTimeline timeline;
+
+    void SetUp() override
+    {
+        std::filesystem::remove(histogramFile);
+
+        // Every phase takes 1ms more than the one before it
+        auto start = LaunchTimeline::Clock::now();
+        auto elapsed = 0ms;
+        for (auto phase : magic_enum::enum_values<LaunchTimeline::Phase>())
+        {
+            elapsed += std::chrono::milliseconds(magic_enum::enum_integer(phase));
+            timeline.mark(phase, start + elapsed);
+        }
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(histogramFile);
+    }
+
+    [[nodiscard]] nlohmann::json histograms() const
+    {
+        std::ifstream file(histogramFile);
+        return nlohmann::json::parse(file);
+    }
+};
+
+/*
+    Asking how long phases took on a complete timeline.
+    Expectation: every phase took the time since the previous one, the first one took none.
+*/
+TEST_F(LaunchTimelineFixture, duration)
+{
+    EXPECT_TRUE(timeline.complete());
+    EXPECT_EQ(timeline.duration(LaunchTimeline::Phase::INPUT_HANDLED), LaunchTimeline::Clock::duration::zero());
+    EXPECT_EQ(timeline.duration(LaunchTimeline::Phase::ROM_VALIDATED), 2ms);
+    EXPECT_EQ(timeline.duration(LaunchTimeline::Phase::MENU_REDRAWN), 5ms);
+    EXPECT_EQ(timeline.summary(), "INPUT_HANDLED +0.00ms, CONTROL_STRING_BUILT +1.00ms, ROM_VALIDATED +2.00ms, "
+                                  "PROCESS_SPAWNED +3.00ms, CHILD_EXITED +4.00ms, MENU_REDRAWN +5.00ms");
+}
+
+/*
+    Asking how long phases took on a timeline with a missing phase.
+    Expectation: the missing phase and the one after it have no duration.
+*/
+TEST_F(LaunchTimelineFixture, durationMissingPhase)
+{
+    timeline.reset();
+    timeline.mark(LaunchTimeline::Phase::INPUT_HANDLED);
+    timeline.mark(LaunchTimeline::Phase::ROM_VALIDATED);
+
+    EXPECT_FALSE(timeline.complete());
+    EXPECT_FALSE(timeline.duration(LaunchTimeline::Phase::CONTROL_STRING_BUILT));
+    EXPECT_FALSE(timeline.duration(LaunchTimeline::Phase::ROM_VALIDATED));
+    EXPECT_EQ(timeline.summary(), "INPUT_HANDLED +0.00ms");
+}
+
+/*
+    Recording the same launch twice for a version and once for another.
+    Expectation: each version has its own histograms, every phase falls twice in the bucket of its duration.
+*/
+TEST_F(LaunchTimelineFixture, record)
+{
+    ASSERT_TRUE(timeline.record(histogramFile, "1.0.0"));
+    ASSERT_TRUE(timeline.record(histogramFile, "1.0.0"));
+    ASSERT_TRUE(timeline.record(histogramFile, "1.1.0"));
+
+    auto json = histograms();
+    ASSERT_TRUE(json.contains("1.0.0"));
+    ASSERT_TRUE(json.contains("1.1.0"));
+
+    // 3000us is at least 2^11 and less than 2^12
+    const auto& spawned = json["1.0.0"]["PROCESS_SPAWNED"];
+    EXPECT_EQ(spawned[LaunchTimeline::COUNT_JSON_FIELD], 2);
+    EXPECT_EQ(spawned[LaunchTimeline::TOTAL_JSON_FIELD], 6000);
+    EXPECT_EQ(spawned[LaunchTimeline::BUCKETS_JSON_FIELD].size(), LaunchTimeline::BUCKETS);
+    EXPECT_EQ(spawned[LaunchTimeline::BUCKETS_JSON_FIELD][12], 2);
+    EXPECT_EQ(json["1.1.0"]["PROCESS_SPAWNED"][LaunchTimeline::COUNT_JSON_FIELD], 1);
+}
+
+/*
+    Recording a launch over a malformed histogram file.
+    Expectation: the file is started over.
+*/
+TEST_F(LaunchTimelineFixture, recordMalformed)
+{
+    std::ofstream(histogramFile) << "{ not json";
+
+    ASSERT_TRUE(timeline.record(histogramFile, "1.0.0"));
+    EXPECT_EQ(histograms()["1.0.0"]["MENU_REDRAWN"][LaunchTimeline::COUNT_JSON_FIELD], 1);
+}
@@ -1,5 +1,11 @@
 #include "model.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <set>
+#include <utility>
+
 #include <gtest/gtest.h>
 
 /*
@@ -42,3 +48,161 @@ TEST(Model, add)
     ASSERT_EQ(elements.size(), 1);
     ASSERT_EQ(*(elements.begin()), TEST_STRING);
 }
+
+/*
+    Viewing the elements of a model.
+    Expectation: the view exposes the elements in insertion order without copying them.
+*/
+TEST(Model, view)
+{
+    const std::vector<std::string> TEST_STRINGS{"first", "second", "third"};
+
+    Model<std::string> model;
+    for (const auto& string : TEST_STRINGS)
+    {
+        model.addElement(string);
+    }
+
+    ASSERT_EQ(model.size(), TEST_STRINGS.size());
+    ASSERT_FALSE(model.empty());
+
+    auto view = model.view();
+    ASSERT_TRUE(std::ranges::equal(view, TEST_STRINGS));
+
+    // Every access returns the very same element stored inside the model
+    ASSERT_EQ(&(*view.begin()), &(*model.view().begin()));
+}
+
+/*
+    Viewing an empty model.
+    Expectation: the view is empty.
+*/
+TEST(Model, viewEmpty)
+{
+    Model<std::string> model;
+
+    ASSERT_TRUE(model.empty());
+    ASSERT_TRUE(model.view().empty());
+}
+
+/*
+    Constructing many model elements.
+    Expectation: every element gets its own uuid.
+*/
+TEST(ModelElement, uniqueUuid)
+{
+    std::set<uuids::uuid> uuids;
+    for (int i = 0; i < 1000; i++)
+    {
+        uuids.insert(ModelElement<int>(i).uuid());
+    }
+
+    ASSERT_EQ(uuids.size(), 1000);
+}
+
+/*
+    Adding many values to the model in one go.
+    Expectation: the model contains every value and a single batched notification is emitted.
+*/
+TEST(Model, addElements)
+{
+    const std::vector<std::string> TEST_STRINGS{"first", "second", "third"};
+
+    Model<std::string> model;
+    model.addElement("zero");
+
+    int batches = 0;
+    int singles = 0;
+    model.onElementAdded([&singles](const uuids::uuid&, const std::string&) { singles++; });
+    model.onElementsAdded([&batches, &TEST_STRINGS](std::span<const ModelElement<std::string>> elements) {
+        batches++;
+        ASSERT_TRUE(std::ranges::equal(elements, TEST_STRINGS, {}, [](const auto& element) { return *element; }));
+    });
+
+    model.addElements(TEST_STRINGS);
+
+    ASSERT_EQ(batches, 1);
+    ASSERT_EQ(singles, 0);
+    ASSERT_EQ(model.size(), TEST_STRINGS.size() + 1);
+}
+
+/*
+    Adding an empty range to the model.
+    Expectation: nothing is added and no notification is emitted.
+*/
+TEST(Model, addElementsEmpty)
+{
+    Model<std::string> model;
+
+    int batches = 0;
+    model.onElementsAdded([&batches](std::span<const ModelElement<std::string>>) { batches++; });
+    model.addElements(std::vector<std::string>{});
+
+    ASSERT_EQ(batches, 0);
+    ASSERT_TRUE(model.empty());
+}
+
+/*
+    Moving move only values into the model, one by one and in bulk.
+    Expectation: the model owns the very same values.
+*/
+TEST(Model, addElementsMove)
+{
+    auto single = std::make_unique<int>(0);
+    const auto* singleAddress = single.get();
+
+    std::vector<std::unique_ptr<int>> values;
+    values.push_back(std::make_unique<int>(1));
+    values.push_back(std::make_unique<int>(2));
+    const auto* bulkAddress = values.back().get();
+
+    Model<std::unique_ptr<int>> model;
+    model.addElement(std::move(single));
+    model.addElements(std::move(values));
+
+    ASSERT_EQ(model.size(), 3);
+    ASSERT_EQ(model.view()[0].get(), singleAddress);
+    ASSERT_EQ(model.view()[2].get(), bulkAddress);
+}
+
+/*
+    Modifying an element of the model.
+    Expectation: the element holds the new value and elementModified is emitted with its uuid.
+*/
+TEST(Model, modifyElement)
+{
+    Model<std::string> model;
+
+    std::optional<uuids::uuid> added;
+    model.onElementAdded([&added](const uuids::uuid& uuid, const std::string&) { added = uuid; });
+    model.addElement("first");
+    ASSERT_TRUE(added);
+
+    std::vector<std::pair<uuids::uuid, std::string>> modifications;
+    model.onElementModified([&modifications](const uuids::uuid& uuid, const std::string& element) {
+        modifications.emplace_back(uuid, element);
+    });
+
+    ASSERT_TRUE(model.modifyElement(*added, "second"));
+    ASSERT_EQ(modifications.size(), 1);
+    EXPECT_EQ(modifications[0].first, *added);
+    EXPECT_EQ(modifications[0].second, "second");
+    EXPECT_EQ(model.view()[0], "second");
+}
+
+/*
+    Modifying an element which is not in the model.
+    Expectation: nothing is modified and elementModified is not emitted.
+*/
+TEST(Model, modifyUnknownElement)
+{
+    Model<std::string> model;
+    model.addElement("first");
+
+    int modifications = 0;
+    model.onElementModified([&modifications](const uuids::uuid&, const std::string&) { modifications++; });
+
+    ASSERT_FALSE(model.modifyElement(ModelElement<std::string>("other").uuid(), "second"));
+    EXPECT_EQ(modifications, 0);
+    EXPECT_EQ(model.view()[0], "first");
+}
@@ -0,0 +1,144 @@
+#include "modelview.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include <gtest/gtest.h>
+
+struct Cartridge
+{
+    std::string title;
+    std::string manufacturer;
+    bool launchable = true;
+
+    bool operator==(const Cartridge&) const = default;
+};
+
+static const auto BY_TITLE = [](const Cartridge& first, const Cartridge& second) { return first.title < second.title; };
+static const auto LAUNCHABLE = [](const Cartridge& cartridge) { return cartridge.launchable; };
+
+static std::vector<std::string> titles(const ModelView<Cartridge>& view)
+{
+    std::vector<std::string> result;
+    for (const auto& cartridge : view.view())
+    {
+        result.push_back(cartridge.title);
+    }
+
+    return result;
+}
+
+/*
+    Building a view over a model which already has elements.
+    Expectation: the view contains the filtered elements in order.
+*/
+TEST(ModelView, construct)
+{
+    Model<Cartridge> model;
+    model.addElement(Cartridge{.title = "sf2", .manufacturer = "Capcom"});
+    model.addElement(Cartridge{.title = "neogeo", .manufacturer = "SNK", .launchable = false});
+    model.addElement(Cartridge{.title = "ffight", .manufacturer = "Capcom"});
+
+    ModelView<Cartridge> view(model, BY_TITLE, LAUNCHABLE);
+
+    ASSERT_EQ(view.size(), 2);
+    ASSERT_EQ(titles(view), (std::vector<std::string>{"ffight", "sf2"}));
+}
+
+/*
+    Adding elements to a model, one by one and in bulk, after the view was built.
+    Expectation: the view picks them up in the right position.
+*/
+TEST(ModelView, add)
+{
+    Model<Cartridge> model;
+    ModelView<Cartridge> view(model, BY_TITLE, LAUNCHABLE);
+    ASSERT_TRUE(view.empty());
+
+    model.addElement(Cartridge{.title = "sf2"});
+    model.addElements(
+        std::vector<Cartridge>{{.title = "mslug"}, {.title = "bios", .launchable = false}, {.title = "dino"}});
+    model.addElement(Cartridge{.title = "aof"});
+
+    ASSERT_EQ(titles(view), (std::vector<std::string>{"aof", "dino", "mslug", "sf2"}));
+}
+
+/*
+    Modifying elements of a model.
+    Expectation: modified elements move to their new position or leave the view when they don't pass the filter.
+*/
+TEST(ModelView, modify)
+{
+    Model<Cartridge> model;
+    model.addElement(Cartridge{.title = "aof"});
+    model.addElement(Cartridge{.title = "dino"});
+    model.addElement(Cartridge{.title = "sf2"});
+    ModelView<Cartridge> view(model, BY_TITLE, LAUNCHABLE);
+
+    std::vector<uuids::uuid> uuids;
+    model.onElementAdded([&uuids](const uuids::uuid& uuid, const Cartridge&) { uuids.push_back(uuid); });
+    model.addElement(Cartridge{.title = "mslug"});
+    model.addElement(Cartridge{.title = "kof98", .launchable = false});
+
+    ASSERT_TRUE(model.modifyElement(uuids[0], Cartridge{.title = "bbusters"}));
+    ASSERT_EQ(titles(view), (std::vector<std::string>{"aof", "bbusters", "dino", "sf2"}));
+
+    ASSERT_TRUE(model.modifyElement(uuids[1], Cartridge{.title = "kof98"}));
+    ASSERT_EQ(titles(view), (std::vector<std::string>{"aof", "bbusters", "dino", "kof98", "sf2"}));
+
+    ASSERT_TRUE(model.modifyElement(uuids[0], Cartridge{.title = "bbusters", .launchable = false}));
+    ASSERT_EQ(titles(view), (std::vector<std::string>{"aof", "dino", "kof98", "sf2"}));
+}
+
+/*
+    Adding elements which compare equivalent.
+    Expectation: all of them are kept, in insertion order.
+*/
+TEST(ModelView, equivalent)
+{
+    Model<Cartridge> model;
+    ModelView<Cartridge> view(model, [](const Cartridge& first, const Cartridge& second) {
+        return first.manufacturer < second.manufacturer;
+    });
+
+    model.addElement(Cartridge{.title = "sf2", .manufacturer = "Capcom"});
+    model.addElement(Cartridge{.title = "mslug", .manufacturer = "SNK"});
+    model.addElement(Cartridge{.title = "ffight", .manufacturer = "Capcom"});
+
+    ASSERT_EQ(titles(view), (std::vector<std::string>{"sf2", "ffight", "mslug"}));
+    ASSERT_EQ(std::vector<std::size_t>(view.indexes().begin(), view.indexes().end()),
+              (std::vector<std::size_t>{0, 2, 1}));
+}
+
+/*
+    Modifying an element which does not belong to the model.
+    Expectation: nothing happens.
+*/
+TEST(ModelView, modifyUnknown)
+{
+    Model<Cartridge> model;
+    model.addElement(Cartridge{.title = "sf2"});
+    ModelView<Cartridge> view(model, BY_TITLE);
+
+    ASSERT_FALSE(model.modifyElement(uuids::uuid{}, Cartridge{.title = "aof"}));
+    ASSERT_EQ(titles(view), (std::vector<std::string>{"sf2"}));
+}
+
+/*
+    Building a view over a model which already has equivalent elements, and then adding more of them.
+    Expectation: equivalent elements keep their insertion order whether they were sorted up front or placed later.
+*/
+TEST(ModelView, constructEquivalent)
+{
+    Model<Cartridge> model;
+    model.addElement(Cartridge{.title = "sf2", .manufacturer = "Capcom"});
+    model.addElement(Cartridge{.title = "mslug", .manufacturer = "SNK"});
+    model.addElement(Cartridge{.title = "ffight", .manufacturer = "Capcom"});
+    ModelView<Cartridge> view(model, [](const Cartridge& first, const Cartridge& second) {
+        return first.manufacturer < second.manufacturer;
+    });
+
+    model.addElement(Cartridge{.title = "dino", .manufacturer = "Capcom"});
+
+    ASSERT_EQ(titles(view), (std::vector<std::string>{"sf2", "ffight", "dino", "mslug"}));
+}
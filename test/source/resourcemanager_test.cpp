@@ -27,3 +27,44 @@ TEST_F(ResourceManagerFixture, get)
     EXPECT_CALL(resourcemanager, loadFromMemory(::testing::_)).Times(0);
     EXPECT_NO_THROW(auto res = resourcemanager.getResource(RESOURCE_PATH));
 }
+
+TEST_F(ResourceManagerFixture, clear)
+{
+    EXPECT_CALL(resourcemanager, loadFromFile(RESOURCE_PATH))
+        .Times(2)
+        .WillRepeatedly(testing::Return(ResourceManager<sf::Font>::MemoryRegion{nullptr, 0}));
+    EXPECT_CALL(resourcemanager, loadFromMemory(::testing::_)).Times(2).WillRepeatedly(testing::Return(sf::Font()));
+
+    // Once cleared, resources are loaded again
+    EXPECT_NO_THROW(auto res = resourcemanager.getResource(RESOURCE_PATH));
+    resourcemanager.clear();
+    EXPECT_NO_THROW(auto res = resourcemanager.getResource(RESOURCE_PATH));
+}
+
+/*
+    Caching resources loaded elsewhere.
+    Expectation: a resource is only cached if it could be loaded, and never loaded again once cached.
+*/
+TEST_F(ResourceManagerFixture, addResource)
+{
+    EXPECT_CALL(resourcemanager, loadFromFile(::testing::_)).Times(0);
+    EXPECT_CALL(resourcemanager, loadFromMemory(::testing::_)).Times(0);
+
+    EXPECT_EQ(resourcemanager.findResource(RESOURCE_PATH), nullptr);
+    EXPECT_EQ(resourcemanager.addResource(RESOURCE_PATH, [](sf::Font&) { return false; }), nullptr);
+    EXPECT_EQ(resourcemanager.findResource(RESOURCE_PATH), nullptr);
+
+    const auto* resource = resourcemanager.addResource(RESOURCE_PATH, [](sf::Font&) { return true; });
+    ASSERT_NE(resource, nullptr);
+    EXPECT_EQ(resourcemanager.findResource(RESOURCE_PATH), resource);
+
+    bool loaded = false;
+    EXPECT_EQ(resourcemanager.addResource(RESOURCE_PATH,
+                                          [&loaded](sf::Font&) {
+                                              loaded = true;
+                                              return true;
+                                          }),
+              resource);
+    EXPECT_FALSE(loaded);
+    EXPECT_NO_THROW(auto res = resourcemanager.getResource(RESOURCE_PATH));
+}
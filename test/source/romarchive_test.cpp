@@ -0,0 +1,197 @@
+#include "rom/archive.hpp"
+
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+static const Rom::File FIRST_FILE{.name = "sf2_30a.bin", .size = 131072, .crc = 0x57bd7051};
+static const Rom::File SECOND_FILE{.name = "sf2_37a.bin", .size = 131072, .crc = 0x8ccbabbe};
+
+/*
+    Helper building the tail of a zip archive: a central directory followed by its end of central directory record.
+    Member data is never read when listing an archive so we do not bother writing it.
+*/
+static std::vector<std::byte> zipArchive(const std::vector<Rom::File>& files, const std::string& comment = "")
+{
+    std::vector<std::byte> result;
+    auto write = [&result](std::uint64_t value, std::size_t bytes) {
+        for (std::size_t i = 0; i < bytes; i++)
+        {
+            result.push_back(static_cast<std::byte>((value >> (8 * i)) & 0xFF));
+        }
+    };
+    auto writeString = [&result](const std::string& string) {
+        for (auto c : string)
+        {
+            result.push_back(static_cast<std::byte>(c));
+        }
+    };
+
+    for (const auto& file : files)
+    {
+        write(0x02014b50, 4); // signature
+        write(20, 2);         // version made by
+        write(20, 2);         // version needed
+        write(0, 2);          // flags
+        write(8, 2);          // compression method
+        write(0, 4);          // modification time and date
+        write(file.crc, 4);
+        write(file.size / 2, 4); // compressed size
+        write(file.size, 4);
+        write(file.name.size(), 2);
+        write(0, 2);  // extra field length
+        write(0, 2);  // comment length
+        write(0, 2);  // disk number
+        write(0, 2);  // internal attributes
+        write(0, 4);  // external attributes
+        write(0, 4);  // local header offset
+        writeString(file.name);
+    }
+
+    const auto directorySize = result.size();
+    write(0x06054b50, 4); // signature
+    write(0, 2);          // disk number
+    write(0, 2);          // central directory disk
+    write(files.size(), 2);
+    write(files.size(), 2);
+    write(directorySize, 4);
+    write(0, 4); // central directory offset
+    write(comment.size(), 2);
+    writeString(comment);
+
+    return result;
+}
+
+/*
+    Listing the members of a well formed archive.
+    Expectation: every member is listed with its name, size and crc.
+*/
+TEST(RomArchive, members)
+{
+    auto archive = zipArchive({FIRST_FILE, SECOND_FILE});
+    auto members = Rom::Archive::members(archive);
+
+    ASSERT_TRUE(members.isRight());
+    ASSERT_EQ(members.getRight().size(), 2);
+    EXPECT_EQ(members.getRight()[0], FIRST_FILE);
+    EXPECT_EQ(members.getRight()[1], SECOND_FILE);
+}
+
+/*
+    Listing the members of an archive with a trailing comment.
+    Expectation: the end of central directory record is found anyway.
+*/
+TEST(RomArchive, membersWithComment)
+{
+    auto archive = zipArchive({FIRST_FILE}, "TORRENTZIPPED-12345678");
+    auto members = Rom::Archive::members(archive);
+
+    ASSERT_TRUE(members.isRight());
+    ASSERT_EQ(members.getRight().size(), 1);
+    EXPECT_EQ(members.getRight()[0], FIRST_FILE);
+}
+
+/*
+    Listing the members of something that is not a zip archive.
+    Expectation: we fail because no end of central directory is found.
+*/
+TEST(RomArchive, membersNotAZip)
+{
+    std::vector<std::byte> archive(128, std::byte{0x42});
+    auto members = Rom::Archive::members(archive);
+
+    ASSERT_TRUE(members.isLeft());
+    EXPECT_EQ(members.getLeft(), Rom::Archive::Error::NO_END_OF_CENTRAL_DIRECTORY);
+}
+
+/*
+    Listing the members of an archive whose central directory got truncated.
+    Expectation: we fail because the central directory is malformed.
+*/
+TEST(RomArchive, membersTruncatedDirectory)
+{
+    auto archive = zipArchive({FIRST_FILE, SECOND_FILE});
+    // Corrupting the signature of the second central directory header
+    archive[46 + FIRST_FILE.name.size()] = std::byte{0};
+    auto members = Rom::Archive::members(archive);
+
+    ASSERT_TRUE(members.isLeft());
+    EXPECT_EQ(members.getLeft(), Rom::Archive::Error::MALFORMED_CENTRAL_DIRECTORY);
+}
+
+/*
+    Listing the members of an archive stored on disk.
+    Expectation: every member is listed.
+*/
+TEST(RomArchive, membersFromFile)
+{
+    const auto path = std::filesystem::temp_directory_path() / "enea_romarchive_test.zip";
+    auto archive = zipArchive({FIRST_FILE, SECOND_FILE});
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(archive.data()), static_cast<std::streamsize>(archive.size()));
+    }
+
+    auto members = Rom::Archive::members(path);
+    std::filesystem::remove(path);
+
+    ASSERT_TRUE(members.isRight());
+    EXPECT_EQ(members.getRight().size(), 2);
+}
+
+/*
+    Listing the members of a non existing archive.
+    Expectation: we fail to open it.
+*/
+TEST(RomArchive, membersNonExistingFile)
+{
+    auto members = Rom::Archive::members(std::filesystem::absolute("nonexisting.zip"));
+
+    ASSERT_TRUE(members.isLeft());
+    EXPECT_EQ(members.getLeft(), Rom::Archive::Error::OPEN_FILE);
+}
+
+/*
+    Auditing an archive which contains every expected member (names differ in case only).
+    Expectation: the audit passes.
+*/
+TEST(RomArchive, auditGood)
+{
+    Rom::File upperCase = FIRST_FILE;
+    upperCase.name = "SF2_30A.BIN";
+
+    EXPECT_EQ(Rom::Archive::audit({upperCase, SECOND_FILE}, {FIRST_FILE, SECOND_FILE}), Rom::Audit::GOOD);
+}
+
+/*
+    Auditing an archive which contains a renamed member.
+    Expectation: the audit passes as the member is found by crc.
+*/
+TEST(RomArchive, auditRenamed)
+{
+    Rom::File renamed = FIRST_FILE;
+    renamed.name = "renamed.bin";
+
+    EXPECT_EQ(Rom::Archive::audit({renamed, SECOND_FILE}, {FIRST_FILE, SECOND_FILE}), Rom::Audit::GOOD);
+}
+
+/*
+    Auditing an archive which misses a member.
+    Expectation: the audit reports missing files.
+*/
+TEST(RomArchive, auditMissingFiles)
+{
+    EXPECT_EQ(Rom::Archive::audit({FIRST_FILE}, {FIRST_FILE, SECOND_FILE}), Rom::Audit::MISSING_FILES);
+}
+
+/*
+    Auditing an archive which contains a member with a wrong crc.
+    Expectation: the audit reports bad files.
+*/
+TEST(RomArchive, auditBadFiles)
+{
+    Rom::File badDump = SECOND_FILE;
+    badDump.crc = 0xdeadbeef;
+
+    EXPECT_EQ(Rom::Archive::audit({FIRST_FILE, badDump}, {FIRST_FILE, SECOND_FILE}), Rom::Audit::BAD_FILES);
+}
@@ -0,0 +1,54 @@
+#include "rom/collation.hpp"
+
+#include <gtest/gtest.h>
+
+using Rom::collationKey;
+
+/*
+    We compare titles which only differ by case.
+    Expectation: they get the same key.
+*/
+TEST(Collation, caseFolding)
+{
+    EXPECT_EQ(collationKey("Metal Slug"), collationKey("METAL SLUG"));
+    EXPECT_LT(collationKey("aero fighters"), collationKey("Bomberman"));
+}
+
+/*
+    We compare titles starting with articles and punctuation.
+    Expectation: articles and leading punctuation are ignored, unless the article is the whole title.
+*/
+TEST(Collation, articlesAndPunctuation)
+{
+    EXPECT_EQ(collationKey("The King of Fighters '98"), collationKey("King of Fighters '98"));
+    EXPECT_EQ(collationKey("An American Tail"), collationKey("american tail"));
+    EXPECT_EQ(collationKey("'88 Games"), collationKey("88 Games"));
+    EXPECT_EQ(collationKey("...And Justice"), collationKey("And Justice"));
+    EXPECT_LT(collationKey("The Ninja Warriors"), collationKey("Pac-Man"));
+    EXPECT_NE(collationKey("A-Jax"), collationKey("Jax"));
+    EXPECT_FALSE(collationKey("The").empty());
+}
+
+/*
+    We compare titles containing numbers.
+    Expectation: numbers compare by value.
+*/
+TEST(Collation, numbers)
+{
+    EXPECT_LT(collationKey("Tekken 2"), collationKey("Tekken 10"));
+    EXPECT_LT(collationKey("19XX"), collationKey("1942"));
+    EXPECT_LT(collationKey("Puzzle Bobble 2"), collationKey("Puzzle Bobble 3"));
+    EXPECT_EQ(collationKey("Stage 007"), collationKey("Stage 7"));
+    EXPECT_LT(collationKey("Stage 0"), collationKey("Stage 1"));
+    EXPECT_LT(collationKey("1943 Kai"), collationKey("Aero Fighters"));
+}
+
+/*
+    We build the key of an empty title.
+    Expectation: the key is empty.
+*/
+TEST(Collation, empty)
+{
+    EXPECT_TRUE(collationKey("").empty());
+    EXPECT_TRUE(collationKey("...").empty());
+}
@@ -0,0 +1,46 @@
+#include "rom/definition.hpp"
+
+#include <gtest/gtest.h>
+
+static const Rom::Info ROM_INFO{.title{"Street Fighter II: The World Warrior"}, .isBios{false}};
+static const Rom::File ROM_FILE{.name = "sf2_30a.bin", .size = 131072, .crc = 0x57bd7051};
+
+/*
+    Building a definition from a database entry which lists the archive members.
+    Expectation: the info is read from the very same object, members are read alongside it.
+*/
+TEST(RomDefinition, fromJson)
+{
+    auto json = nlohmann::json(ROM_INFO);
+    json[Rom::Definition::FILES_JSON_FIELD] = std::vector<Rom::File>{ROM_FILE};
+
+    auto definition = json.template get<Rom::Definition>();
+
+    EXPECT_EQ(definition.info, ROM_INFO);
+    ASSERT_TRUE(definition.files);
+    EXPECT_EQ(*definition.files, std::vector<Rom::File>{ROM_FILE});
+}
+
+/*
+    Building a definition from a database entry which does not list the archive members.
+    Expectation: the definition has no member list.
+*/
+TEST(RomDefinition, fromJsonWithoutFiles)
+{
+    auto definition = nlohmann::json(ROM_INFO).template get<Rom::Definition>();
+
+    EXPECT_EQ(definition.info, ROM_INFO);
+    EXPECT_FALSE(definition.files);
+}
+
+/*
+    Storing a rom info as json.
+    Expectation: member lists never end up in it, they only belong to the database.
+*/
+TEST(RomDefinition, infoWithoutFiles)
+{
+    auto json = nlohmann::json(Rom::Definition{.info{ROM_INFO}, .files{{ROM_FILE}}});
+
+    EXPECT_TRUE(json.contains(Rom::Definition::FILES_JSON_FIELD));
+    EXPECT_FALSE(nlohmann::json(ROM_INFO).contains(Rom::Definition::FILES_JSON_FIELD));
+}
@@ -155,6 +155,19 @@ TEST(Game, toJsonMissingMedia)
     EXPECT_FALSE(json.contains(Game::MEDIA_JSON_FIELD));
 }
 
+/*
+    We convert an audited game to a json and back.
+    Expectation: the audit result is preserved.
+*/
+TEST(Game, auditJsonRoundTrip)
+{
+    nlohmann::json json(Rom::Game(ROM_PATH, INFO_COMPLETE, MEDIA_COMPLETE, Rom::Audit::BAD_FILES));
+    auto game = Game{json};
+
+    ASSERT_TRUE(game.audit());
+    EXPECT_EQ(*(game.audit()), Rom::Audit::BAD_FILES);
+}
+
 /*
     We compare two games.
     Expectation: they are equal if their path matches.
@@ -177,3 +190,18 @@ TEST(Game, toString)
     Rom::Game game(ROM_PATH, INFO_COMPLETE);
     EXPECT_EQ(game.toString(), ROM_TITLE);
 }
+
+/*
+    We access the fields of a game more than once.
+    Expectation: we always get references to the very same data owned by the game, nothing is copied.
+*/
+TEST(Game, accessorsDoNotCopy)
+{
+    Rom::Game game(ROM_PATH, INFO_COMPLETE, MEDIA_COMPLETE);
+
+    EXPECT_EQ(&game.path(), &game.path());
+    EXPECT_EQ(&game.info(), &game.info());
+    EXPECT_EQ(&game.media(), &game.media());
+    EXPECT_EQ(game.title(), ROM_TITLE);
+    EXPECT_EQ(game.title().data(), game.info().title.data());
+}
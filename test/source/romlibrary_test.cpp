@@ -0,0 +1,143 @@
+#include "rom/library.hpp"
+
+#include <gtest/gtest.h>
+
+static const std::filesystem::path ROM_FOLDER = std::filesystem::absolute("roms");
+
+static const Rom::Game SF2{ROM_FOLDER / "sf2.zip",
+                           Rom::Info{.title = "Street Fighter II: The World Warrior",
+                                     .year = "1991",
+                                     .manufacturer = "Capcom",
+                                     .isBios = false},
+                           Rom::Media{.screenshot = ROM_FOLDER / "sf2.png"}, Rom::Audit::GOOD};
+
+static const Rom::Game FFIGHT{ROM_FOLDER / "ffight.zip",
+                              Rom::Info{.title = "Final Fight (World)", .year = "1989", .manufacturer = "Capcom"}};
+
+static const Rom::Game NEOGEO{ROM_FOLDER / "bios" / "neogeo.zip", Rom::Info{.title = "Neo-Geo", .isBios = true}};
+
+/*
+    We build a library out of a list of games.
+    Expectation: every entry reports the same data of the game it was built from.
+*/
+TEST(Library, construct)
+{
+    const std::vector<Rom::Game> games{SF2, FFIGHT, NEOGEO};
+    Rom::Library library(games);
+
+    ASSERT_EQ(library.size(), games.size());
+    for (Rom::Library::Index i = 0; i < games.size(); i++)
+    {
+        auto entry = library[i];
+        EXPECT_EQ(entry.index(), i);
+        EXPECT_EQ(entry.path(), games[i].path());
+        EXPECT_EQ(entry.title(), games[i].info().title);
+        EXPECT_EQ(entry.year(), games[i].info().year);
+        EXPECT_EQ(entry.manufacturer(), games[i].info().manufacturer);
+        EXPECT_EQ(entry.audit(), games[i].audit());
+    }
+
+    EXPECT_EQ(library[0].fileName(), "sf2.zip");
+    EXPECT_EQ(library[0].stem(), "sf2");
+    EXPECT_EQ(library[0].screenshot(), SF2.media()->screenshot);
+    EXPECT_FALSE(library[1].screenshot());
+}
+
+/*
+    We build a library and materialize its entries back into games.
+    Expectation: the materialized games are equal to the original ones.
+*/
+TEST(Library, game)
+{
+    const std::vector<Rom::Game> games{SF2, FFIGHT, NEOGEO};
+    Rom::Library library(games);
+
+    for (Rom::Library::Index i = 0; i < games.size(); i++)
+    {
+        auto game = library[i].game();
+        EXPECT_EQ(game, games[i]);
+        EXPECT_EQ(game.info(), games[i].info());
+        EXPECT_EQ(game.media(), games[i].media());
+        EXPECT_EQ(game.audit(), games[i].audit());
+    }
+}
+
+/*
+    We build a library out of a clone and a game running on a bios.
+    Expectation: entries report the sets they depend on and keep them when materialized back into games.
+*/
+TEST(Library, parentAndBios)
+{
+    const std::vector<Rom::Game> games{
+        Rom::Game(ROM_FOLDER / "sf2ce.zip", Rom::Info{.title = "Street Fighter II': CE", .parent = "sf2"}),
+        Rom::Game(ROM_FOLDER / "mslug.zip", Rom::Info{.title = "Metal Slug", .bios = "neogeo"})};
+    Rom::Library library(games);
+
+    EXPECT_EQ(library[0].parent(), "sf2");
+    EXPECT_FALSE(library[0].bios());
+    EXPECT_FALSE(library[1].parent());
+    EXPECT_EQ(library[1].bios(), "neogeo");
+    EXPECT_EQ(library[0].game().info(), games[0].info());
+    EXPECT_EQ(library[1].game().info(), games[1].info());
+}
+
+/*
+    We build an empty library.
+    Expectation: it is empty and iterating it does nothing.
+*/
+TEST(Library, empty)
+{
+    Rom::Library library;
+
+    EXPECT_TRUE(library.empty());
+    EXPECT_EQ(library.begin(), library.end());
+    EXPECT_TRUE(library.orderByTitle().empty());
+}
+
+/*
+    We iterate over a library.
+    Expectation: entries are visited in insertion order.
+*/
+TEST(Library, iterate)
+{
+    Rom::Library library(std::vector<Rom::Game>{SF2, FFIGHT, NEOGEO});
+
+    std::vector<std::string_view> titles;
+    for (const auto& entry : library)
+    {
+        titles.push_back(entry.title());
+    }
+
+    EXPECT_EQ(titles, (std::vector<std::string_view>{SF2.info().title, FFIGHT.info().title, NEOGEO.info().title}));
+}
+
+/*
+    We order a library by title.
+    Expectation: indexes are sorted by title and the library itself is untouched.
+*/
+TEST(Library, orderByTitle)
+{
+    Rom::Library library(std::vector<Rom::Game>{SF2, FFIGHT, NEOGEO});
+
+    EXPECT_EQ(library.orderByTitle(), (std::vector<Rom::Library::Index>{1, 2, 0}));
+    EXPECT_EQ(library[0].title(), SF2.info().title);
+}
+
+/*
+    We add many games sharing the same folder and manufacturer to a library.
+    Expectation: entries stay valid while the library grows.
+*/
+TEST(Library, grow)
+{
+    Rom::Library library;
+    for (int i = 0; i < 1000; i++)
+    {
+        library.add(Rom::Game{ROM_FOLDER / fmt::format("rom{}.zip", i),
+                              Rom::Info{.title = fmt::format("Rom {}", i), .manufacturer = "Capcom"}});
+    }
+
+    ASSERT_EQ(library.size(), 1000);
+    EXPECT_EQ(library[0].path(), ROM_FOLDER / "rom0.zip");
+    EXPECT_EQ(library[999].title(), "Rom 999");
+    EXPECT_EQ(library[500].manufacturer(), "Capcom");
+}
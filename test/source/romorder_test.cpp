@@ -0,0 +1,94 @@
+#include "rom/order.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include <gtest/gtest.h>
+
+static std::shared_ptr<const Rom::Library> randomLibrary(std::size_t size)
+{
+    std::mt19937 generator(42); // NOLINT
+    std::uniform_int_distribution<int> letter('a', 'z');
+
+    auto library = std::make_shared<Rom::Library>();
+    for (std::size_t i = 0; i < size; i++)
+    {
+        std::string title(8, ' ');
+        std::ranges::generate(title, [&]() { return static_cast<char>(letter(generator)); });
+        library->add(Rom::Game{fmt::format("/roms/rom{}.zip", i), Rom::Info{.title = title}});
+    }
+
+    return library;
+}
+
+// Every index of the library sorted the way a view does it: equivalent entries keep their library order
+static std::vector<Rom::Library::Index> sorted(Rom::Sort sort, const Rom::Library& library)
+{
+    std::vector<Rom::Library::Index> result(library.size());
+    std::iota(result.begin(), result.end(), 0);
+    std::ranges::sort(result, [sort, &library](Rom::Library::Index first, Rom::Library::Index second) {
+        if (Rom::precedes(sort, library[first], library[second]))
+        {
+            return true;
+        }
+
+        return !Rom::precedes(sort, library[second], library[first]) && first < second;
+    });
+
+    return result;
+}
+
+/*
+    We sort a big library by title.
+    Expectation: the order matches the one of the library itself.
+*/
+TEST(Order, byTitle)
+{
+    auto library = randomLibrary(10000);
+    const auto expected = library->orderByTitle();
+
+    auto order = sorted(Rom::Sort::TITLE, *library);
+    ASSERT_EQ(order.size(), expected.size());
+
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        EXPECT_EQ((*library)[order[i]].title(), (*library)[expected[i]].title());
+    }
+}
+
+/*
+    We compare an entry with itself.
+    Expectation: no entry precedes itself, whatever the order.
+*/
+TEST(Order, irreflexive)
+{
+    auto library = randomLibrary(1);
+
+    for (auto sort : {Rom::Sort::TITLE, Rom::Sort::YEAR, Rom::Sort::MANUFACTURER})
+    {
+        EXPECT_FALSE(Rom::precedes(sort, (*library)[0], (*library)[0]));
+    }
+}
+
+/*
+    We sort a small library by year and by manufacturer.
+    Expectation: entries are sorted by the chosen field, then by title, and entries missing the field come last.
+*/
+TEST(Order, byYearAndManufacturer)
+{
+    auto library = std::make_shared<Rom::Library>();
+    library->add(
+        Rom::Game{"/roms/sf2.zip", Rom::Info{.title = "Street Fighter II", .year = "1991", .manufacturer = "Capcom"}});
+    library->add(
+        Rom::Game{"/roms/mslug.zip", Rom::Info{.title = "Metal Slug", .year = "1996", .manufacturer = "Nazca"}});
+    library->add(Rom::Game{"/roms/unknown.zip", Rom::Info{.title = "Unknown"}});
+    library->add(
+        Rom::Game{"/roms/ffight.zip", Rom::Info{.title = "Final Fight", .year = "1989", .manufacturer = "capcom"}});
+    library->add(Rom::Game{"/roms/dino.zip",
+                           Rom::Info{.title = "Cadillacs and Dinosaurs", .year = "1991", .manufacturer = "Capcom"}});
+
+    EXPECT_EQ(sorted(Rom::Sort::YEAR, *library), (std::vector<Rom::Library::Index>{3, 4, 0, 1, 2}));
+    EXPECT_EQ(sorted(Rom::Sort::MANUFACTURER, *library), (std::vector<Rom::Library::Index>{4, 3, 0, 1, 2}));
+    EXPECT_EQ(sorted(Rom::Sort::TITLE, *library), (std::vector<Rom::Library::Index>{4, 3, 1, 0, 2}));
+}
@@ -0,0 +1,73 @@
+#include "rom/prefetcher.hpp"
+
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+class PrefetcherFixture : public ::testing::Test
+{
+ protected:
+    static inline const std::filesystem::path base = std::filesystem::temp_directory_path() / "enea_prefetcher_test";
+    static constexpr std::uint64_t ROM_SIZE = 3 * Rom::Prefetcher::CHUNK + 512;
+
+    static void SetUpTestSuite()
+    {
+        std::filesystem::create_directories(base);
+        for (const auto* name : {"mslug.zip", "neogeo.zip", "sf2.zip"})
+        {
+            std::ofstream(base / name) << std::string(ROM_SIZE, 'x');
+        }
+    }
+
+    static void TearDownTestSuite()
+    {
+        std::filesystem::remove_all(base);
+    }
+};
+
+/*
+    Listing the files of a rom whose bios is next to it and whose parent is missing.
+    Expectation: we get the rom archive and the bios one.
+*/
+TEST_F(PrefetcherFixture, files)
+{
+    Rom::Library library(std::vector<Rom::Game>{
+        Rom::Game(base / "mslug.zip", Rom::Info{.title = "Metal Slug", .parent = "mslugo", .bios = "neogeo"})});
+
+    EXPECT_EQ(Rom::Prefetcher::files(library[0]),
+              (std::vector<std::filesystem::path>{base / "mslug.zip", base / "neogeo.zip"}));
+}
+
+#ifdef TARGET_OS_LINUX
+/*
+    Prefetching two files, then prefetching again with a budget smaller than a file.
+    Expectation: both files are read whole the first time, the second time reading stops at the budget.
+*/
+TEST_F(PrefetcherFixture, prefetch)
+{
+    Rom::Prefetcher prefetcher;
+    prefetcher.prefetch({base / "mslug.zip", base / "neogeo.zip", base / "missing.zip"});
+    prefetcher.wait();
+    EXPECT_EQ(prefetcher.prefetched(), 2 * ROM_SIZE);
+
+    Rom::Prefetcher bounded(Rom::Prefetcher::CHUNK * 2);
+    bounded.prefetch({base / "sf2.zip", base / "neogeo.zip"});
+    bounded.wait();
+    EXPECT_EQ(bounded.prefetched(), Rom::Prefetcher::CHUNK * 2);
+}
+#endif
+
+/*
+    Cancelling a request and destroying a prefetcher while it is busy.
+    Expectation: waiting returns right away and nothing hangs.
+*/
+TEST_F(PrefetcherFixture, cancel)
+{
+    Rom::Prefetcher prefetcher;
+    prefetcher.prefetch({base / "mslug.zip", base / "neogeo.zip", base / "sf2.zip"});
+    prefetcher.cancel();
+    prefetcher.wait();
+    EXPECT_LE(prefetcher.prefetched(), 3 * ROM_SIZE);
+
+    prefetcher.prefetch({base / "sf2.zip"});
+}
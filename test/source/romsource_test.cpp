@@ -3,6 +3,21 @@
 static const std::filesystem::path VALID_ROM_PATH = std::filesystem::absolute("sf2.zip");
 static const Rom::Info VALID_ROM_INFO{.title{"Street Fighter II"}, .isBios{false}};
 
+// The roms a source published in its library, as standalone games
+static std::vector<Rom::Game> games(const Rom::Source& source)
+{
+    std::vector<Rom::Game> result;
+    if (auto library = source.library().load(); library)
+    {
+        for (const auto& rom : *library)
+        {
+            result.push_back(rom.game());
+        }
+    }
+
+    return result;
+}
+
 /*
     We start monitoring a rom source with no cache available.
     Expectation: we scan the rom source and we find all the roms.
@@ -28,26 +43,28 @@ TEST(RomSource, scan)
     EXPECT_CALL(source, scan()).WillOnce(testing::Return(fileList));
 
     // zip extension, we expect the database to be queried
-    EXPECT_CALL(source, romInfo(VALID_ROM_PATH)).WillOnce(testing::Return(VALID_ROM_INFO));
+    EXPECT_CALL(source, definition(VALID_ROM_PATH)).WillOnce(testing::Return(Rom::Definition{.info{VALID_ROM_INFO}}));
 
     // zip extension, we expect the database to be queried
-    EXPECT_CALL(source, romInfo(INVALID_ROM_PATH)).WillOnce(testing::Return(std::nullopt));
+    EXPECT_CALL(source, definition(INVALID_ROM_PATH)).WillOnce(testing::Return(std::nullopt));
 
     // zip extension, we expect the database to be queried
-    EXPECT_CALL(source, romInfo(UNLAUNCHABLE_ROM_PATH)).WillOnce(testing::Return(UNLAUNCHABLE_ROM_INFO));
+    EXPECT_CALL(source, definition(UNLAUNCHABLE_ROM_PATH))
+        .WillOnce(testing::Return(Rom::Definition{.info{UNLAUNCHABLE_ROM_INFO}}));
 
     // zip extension, we expect the database to be queried
-    EXPECT_CALL(source, romInfo(NOSCREENSHOT_ROM_PATH)).WillOnce(testing::Return(NOSCREENSHOT_ROM_INFO));
+    EXPECT_CALL(source, definition(NOSCREENSHOT_ROM_PATH))
+        .WillOnce(testing::Return(Rom::Definition{.info{NOSCREENSHOT_ROM_INFO}}));
 
     // bat extensione, we expect the database not to be queried
-    EXPECT_CALL(source, romInfo(UNKNOWN_FILE_PATH)).Times(0);
+    EXPECT_CALL(source, definition(UNKNOWN_FILE_PATH)).Times(0);
 
     // png extensione, we expect the database not to be queried
-    EXPECT_CALL(source, romInfo(SCREENSHOT_FILE_PATH)).Times(0);
+    EXPECT_CALL(source, definition(SCREENSHOT_FILE_PATH)).Times(0);
 
     source.monitor();
 
-    auto roms = source.elements();
+    auto roms = games(source);
 
     EXPECT_EQ(roms.size(), 2);
 
@@ -79,7 +96,7 @@ TEST(RomSource, scan)
     ASSERT_TRUE(missingScreenshotRom != roms.end());
     EXPECT_EQ(missingScreenshotRom->path(), NOSCREENSHOT_ROM_PATH);
     EXPECT_EQ(missingScreenshotRom->info(), NOSCREENSHOT_ROM_INFO);
-    EXPECT_EQ(missingScreenshotRom->media(), Rom::Media{.screenshot{std::nullopt}});
+    EXPECT_FALSE(missingScreenshotRom->media());
 }
 
 /*
@@ -102,7 +119,7 @@ TEST(RomSource, cache)
 
     source.monitor();
 
-    auto roms = source.elements();
+    auto roms = games(source);
     EXPECT_EQ(roms.size(), 1);
 }
 
@@ -339,3 +356,51 @@ TEST(RomSource, writeCacheErrorWrite)
     EXPECT_CALL(source, writeCacheFile(testing::_, testing::_)).WillOnce(testing::Return(false));
     EXPECT_FALSE(source.writeCache());
 }
+
+/*
+    We start monitoring a rom source with no cache available and one of the roms fails its audit.
+    Expectation: the broken rom is not listed in the source.
+*/
+TEST(RomSource, scanBrokenRom)
+{
+    const std::filesystem::path BROKEN_ROM_PATH = std::filesystem::absolute("mslug.zip");
+    const Rom::Info BROKEN_ROM_INFO{.title{"Metal Slug"}, .isBios{false}};
+
+    Rom::SourceMock source("test", std::filesystem::absolute("cachedir"));
+    EXPECT_CALL(source, readCacheFile(testing::_)).WillOnce(testing::Return(std::nullopt));
+    EXPECT_CALL(source, scan())
+        .WillOnce(testing::Return(std::vector<std::filesystem::path>{VALID_ROM_PATH, BROKEN_ROM_PATH}));
+    EXPECT_CALL(source, definition(VALID_ROM_PATH)).WillOnce(testing::Return(Rom::Definition{.info{VALID_ROM_INFO}}));
+    EXPECT_CALL(source, definition(BROKEN_ROM_PATH)).WillOnce(testing::Return(Rom::Definition{.info{BROKEN_ROM_INFO}}));
+    EXPECT_CALL(source, audit(VALID_ROM_PATH, testing::_)).WillOnce(testing::Return(Rom::Audit::GOOD));
+    EXPECT_CALL(source, audit(BROKEN_ROM_PATH, testing::_)).WillOnce(testing::Return(Rom::Audit::MISSING_FILES));
+
+    source.monitor();
+
+    auto roms = games(source);
+    ASSERT_EQ(roms.size(), 1);
+    EXPECT_EQ(roms[0].path(), VALID_ROM_PATH);
+    EXPECT_EQ(roms[0].audit(), Rom::Audit::GOOD);
+}
+
+/*
+    We monitor a rom source and read its published library.
+    Expectation: nothing is published before monitoring, afterwards the library holds the very same roms.
+*/
+TEST(RomSource, publishLibrary)
+{
+    Rom::SourceMock source("test", std::filesystem::absolute("cachedir"));
+    EXPECT_CALL(source, readCacheFile(testing::_)).WillOnce(testing::Return(std::nullopt));
+    EXPECT_CALL(source, scan()).WillOnce(testing::Return(std::vector<std::filesystem::path>{VALID_ROM_PATH}));
+    EXPECT_CALL(source, definition(VALID_ROM_PATH)).WillOnce(testing::Return(Rom::Definition{.info{VALID_ROM_INFO}}));
+
+    Snapshot<Rom::Library>::Reader reader(source.library());
+    EXPECT_EQ(reader.get(), nullptr);
+
+    source.monitor();
+
+    ASSERT_TRUE(reader.refresh());
+    ASSERT_EQ(reader.get()->size(), 1);
+    EXPECT_EQ((*reader.get())[0].path(), VALID_ROM_PATH);
+    EXPECT_EQ((*reader.get())[0].title(), VALID_ROM_INFO.title);
+}
@@ -0,0 +1,159 @@
+#include "romtree.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <random>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "utils/filesystem.hpp"
+
+/*
+    These tests run every phase of the rom scan pipeline against two synthetic rom folders, the big one SCALE times
+    the small one, and fail when a phase grows way more than the folder does (eg: an accidental quadratic algorithm).
+    Both folders are measured on the same machine a moment apart, so a slow or loaded machine slows both down and does
+    not fail the tests the way absolute time budgets would.
+    For accurate numbers build with BUILD_BENCHMARKS and run the benchmark instead.
+*/
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+static constexpr std::size_t ITERATIONS = 5;
+static constexpr std::size_t SMALL_ROMS = 500;
+static constexpr std::size_t SCALE = 4;
+// A linear phase grows SCALE times, a quadratic one SCALE * SCALE times
+static constexpr double MAX_GROWTH = SCALE * 2.5;
+// Below this a phase is too quick to tell its growth apart from noise
+static constexpr Milliseconds NOISE_FLOOR{20};
+
+class ScanPerformance : public ::testing::Test
+{
+ protected:
+    static inline std::filesystem::path base;
+    static inline std::unique_ptr<Bench::RomTree> smallTree;
+    static inline std::unique_ptr<Bench::RomTree> bigTree;
+
+    static Bench::TreeShape shape(std::size_t roms)
+    {
+        return Bench::TreeShape{.roms = roms, .screenshots = roms / 2, .unknownFiles = roms / 10, .depth = 3};
+    }
+
+    static void SetUpTestSuite()
+    {
+        // Every test process gets a folder of its own, tests run in parallel never share (or remove) each other trees
+        std::random_device random;
+        base = std::filesystem::temp_directory_path() / fmt::format("enea_scan_test_{:08x}{:08x}", random(), random());
+
+        smallTree = std::make_unique<Bench::RomTree>(base / "small", shape(SMALL_ROMS));
+        bigTree = std::make_unique<Bench::RomTree>(base / "big", shape(SMALL_ROMS * SCALE));
+        std::filesystem::create_directories(base / "cache");
+    }
+
+    static void TearDownTestSuite()
+    {
+        smallTree.reset();
+        bigTree.reset();
+        std::filesystem::remove_all(base);
+    }
+
+    // The quickest of a few runs, the one least disturbed by whatever else the machine is doing
+    static Milliseconds measure(const std::function<void()>& phase)
+    {
+        std::vector<Milliseconds> runs;
+        for (std::size_t i = 0; i < ITERATIONS; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            phase();
+            runs.emplace_back(std::chrono::steady_clock::now() - start);
+        }
+
+        return std::ranges::min(runs);
+    }
+
+    static void expectLinear(const Milliseconds small, const Milliseconds big)
+    {
+        EXPECT_LT(big, std::max(small * MAX_GROWTH, NOISE_FLOOR))
+            << fmt::format("{:.2f}ms with {} roms, {:.2f}ms with {} roms", small.count(), SMALL_ROMS, big.count(),
+                           SMALL_ROMS * SCALE);
+    }
+};
+
+/*
+    Listing both synthetic rom folders.
+    Expectation: listing grows linearly with the folder.
+*/
+TEST_F(ScanPerformance, fileList)
+{
+    expectLinear(measure([]() { std::ignore = utils::filesystem::fileList(smallTree->root()); }),
+                 measure([]() { std::ignore = utils::filesystem::fileList(bigTree->root()); }));
+}
+
+/*
+    Scanning both synthetic rom folders.
+    Expectation: every file is found and scanning grows linearly with the folder.
+*/
+TEST_F(ScanPerformance, scan)
+{
+    Rom::Folder smallFolder(smallTree->root(), base / "cache");
+    Rom::Folder bigFolder(bigTree->root(), base / "cache");
+    Bench::Pipeline small(smallFolder);
+    Bench::Pipeline big(bigFolder);
+
+    EXPECT_EQ(small.scan().size(), smallTree->files());
+    EXPECT_EQ(big.scan().size(), bigTree->files());
+    expectLinear(measure([&small]() { std::ignore = small.scan(); }),
+                 measure([&big]() { std::ignore = big.scan(); }));
+}
+
+/*
+    Retrieving the last modification time of both synthetic rom folders.
+    Expectation: it grows linearly with the folder.
+*/
+TEST_F(ScanPerformance, lastModified)
+{
+    Rom::Folder smallFolder(smallTree->root(), base / "cache");
+    Rom::Folder bigFolder(bigTree->root(), base / "cache");
+    Bench::Pipeline small(smallFolder);
+    Bench::Pipeline big(bigFolder);
+
+    expectLinear(measure([&small]() { std::ignore = small.lastModified(); }),
+                 measure([&big]() { std::ignore = big.lastModified(); }));
+}
+
+/*
+    Parsing both synthetic rom folders.
+    Expectation: every rom is recognized and parsing grows linearly with the folder.
+*/
+TEST_F(ScanPerformance, parse)
+{
+    Rom::Folder smallFolder(smallTree->root(), base / "cache");
+    Rom::Folder bigFolder(bigTree->root(), base / "cache");
+    Bench::Pipeline small(smallFolder);
+    Bench::Pipeline big(bigFolder);
+
+    EXPECT_EQ(small.parse().size(), SMALL_ROMS);
+    EXPECT_EQ(big.parse().size(), SMALL_ROMS * SCALE);
+    expectLinear(measure([&small]() { std::ignore = small.parse(); }),
+                 measure([&big]() { std::ignore = big.parse(); }));
+}
+
+/*
+    Writing and then reading back the cache of both synthetic rom folders.
+    Expectation: both grow linearly with the folder.
+*/
+TEST_F(ScanPerformance, cache)
+{
+    Rom::Folder smallFolder(smallTree->root(), base / "cache");
+    Rom::Folder bigFolder(bigTree->root(), base / "cache");
+    smallFolder.monitor();
+    bigFolder.monitor();
+
+    expectLinear(measure([&smallFolder]() { ASSERT_TRUE(smallFolder.writeCache()); }),
+                 measure([&bigFolder]() { ASSERT_TRUE(bigFolder.writeCache()); }));
+
+    Bench::Pipeline small(smallFolder);
+    Bench::Pipeline big(bigFolder);
+    expectLinear(measure([&small]() { ASSERT_TRUE(small.cache()); }), measure([&big]() { ASSERT_TRUE(big.cache()); }));
+}
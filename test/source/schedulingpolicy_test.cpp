@@ -0,0 +1,139 @@
+#include "schedulingpolicy.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#ifdef TARGET_OS_LINUX
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "systemcommand.hpp"
+#endif
+
+static const std::filesystem::path POLICY_FILE = std::filesystem::temp_directory_path() / "enea_scheduling.json";
+
+/*
+    Converting a policy with every setting to json and back.
+    Expectation: we get the same policy.
+*/
+TEST(SchedulingPolicy, jsonRoundTrip)
+{
+    SchedulingPolicy policy{.emulatorCores{std::vector<unsigned int>{2, 3}},
+                            .eneaCores{std::vector<unsigned int>{0}},
+                            .niceness{-5},
+                            .scheduler{SchedulingPolicy::Scheduler::FIFO},
+                            .priority{10},
+                            .limits{{SchedulingPolicy::Limit::CORE, 0}, {SchedulingPolicy::Limit::NOFILE, 1024}},
+                            .cgroup{"/sys/fs/cgroup/enea/emulator"},
+                            .cgroupSettings{{"cpu.weight", "1000"}}};
+
+    EXPECT_EQ(nlohmann::json(policy).get<SchedulingPolicy>(), policy);
+}
+
+/*
+    Building a policy from an empty json.
+    Expectation: we get the default policy, which is empty.
+*/
+TEST(SchedulingPolicy, fromEmptyJson)
+{
+    auto policy = nlohmann::json::object().get<SchedulingPolicy>();
+
+    EXPECT_EQ(policy, SchedulingPolicy{});
+    EXPECT_TRUE(policy.empty());
+}
+
+/*
+    Building a policy from a json with a scheduler which does not exist.
+    Expectation: we throw.
+*/
+TEST(SchedulingPolicy, fromJsonUnknownScheduler)
+{
+    auto json = nlohmann::json{{SchedulingPolicy::SCHEDULER_JSON_FIELD, "DEADLINE"}};
+
+    EXPECT_THROW(json.get<SchedulingPolicy>(), enea::Exception);
+}
+
+/*
+    Building a policy from a json with a limit which does not exist.
+    Expectation: we throw.
+*/
+TEST(SchedulingPolicy, fromJsonUnknownLimit)
+{
+    auto json = nlohmann::json{{SchedulingPolicy::LIMITS_JSON_FIELD, {{"STACK", 8192}}}};
+
+    EXPECT_THROW(json.get<SchedulingPolicy>(), enea::Exception);
+}
+
+/*
+    Reading a policy from a file which does not exist and from a malformed one.
+    Expectation: we get the default policy in both cases.
+*/
+TEST(SchedulingPolicy, fromFileFallback)
+{
+    std::filesystem::remove(POLICY_FILE);
+    EXPECT_TRUE(SchedulingPolicy::fromFile(POLICY_FILE).empty());
+
+    std::ofstream(POLICY_FILE) << R"({"niceness": )";
+    EXPECT_TRUE(SchedulingPolicy::fromFile(POLICY_FILE).empty());
+
+    std::filesystem::remove(POLICY_FILE);
+}
+
+/*
+    Reading a policy from a file.
+    Expectation: we get the policy written in it.
+*/
+TEST(SchedulingPolicy, fromFile)
+{
+    std::ofstream(POLICY_FILE) << R"({"niceness": 5, "scheduler": "BATCH"})";
+    auto policy = SchedulingPolicy::fromFile(POLICY_FILE);
+
+    EXPECT_EQ(policy.niceness, 5);
+    EXPECT_EQ(policy.scheduler, SchedulingPolicy::Scheduler::BATCH);
+    EXPECT_FALSE(policy.empty());
+
+    std::filesystem::remove(POLICY_FILE);
+}
+
+#ifdef TARGET_OS_LINUX
+/*
+    Applying a policy which only needs unprivileged settings to a running process.
+    Expectation: the process is running with those settings.
+*/
+TEST(SchedulingPolicy, apply)
+{
+    SystemCommand cmd(std::vector<std::string>{"sleep", "5"});
+    auto process = cmd.spawn();
+    ASSERT_TRUE(process.isRight());
+    auto pid = process.getRight()->pid();
+
+    // Any core this test may run on, containers and cpusets do not always include the first one
+    cpu_set_t allowed;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    unsigned int core = 0;
+    while (!CPU_ISSET(core, &allowed))
+    {
+        core++;
+    }
+
+    SchedulingPolicy policy{.emulatorCores{std::vector<unsigned int>{core}},
+                            .niceness{getpriority(PRIO_PROCESS, 0) + 1},
+                            .limits{{SchedulingPolicy::Limit::CORE, 0}}};
+    policy.apply(pid);
+
+    cpu_set_t cores;
+    ASSERT_EQ(sched_getaffinity(pid, sizeof(cores), &cores), 0);
+    EXPECT_EQ(CPU_COUNT(&cores), 1);
+    EXPECT_TRUE(CPU_ISSET(core, &cores));
+    EXPECT_EQ(getpriority(PRIO_PROCESS, static_cast<id_t>(pid)), *policy.niceness);
+
+    rlimit coreLimit;
+    ASSERT_EQ(prlimit(pid, RLIMIT_CORE, nullptr, &coreLimit), 0);
+    EXPECT_EQ(coreLimit.rlim_cur, 0);
+
+    process.getRight()->cancel();
+}
+#endif
@@ -1,7 +1,19 @@
 #include "systemcommand_mock.hpp"
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#ifdef TARGET_OS_LINUX
+#include <signal.h>
+#endif
+
 /*
     Launching a command with a failure
     Expectation: the error code is returned
@@ -38,3 +50,180 @@ TEST(SystemCommand, launch)
     EXPECT_EQ(result.getRight().exitCode, returnCode);
     EXPECT_EQ(result.getRight().output, cmdOutput);
 }
+
+#ifdef TARGET_OS_LINUX
+/*
+    Spawning a command which writes something and exits
+    Expectation: output is streamed line by line and the exit code is returned once it is over
+*/
+TEST(SystemCommand, spawn)
+{
+    std::vector<std::string> lines;
+    auto process = SystemCommand("printf 'one\\ntwo\\nthree'; exit 3").spawn(SystemCommand::Capture{
+        .onLine = [&lines](auto line) { lines.emplace_back(line); }});
+    ASSERT_TRUE(process.isRight());
+
+    auto result = process.getRight()->wait();
+    EXPECT_EQ(result.exitCode, 3);
+    EXPECT_EQ(result.output, "one\ntwo\nthree");
+    EXPECT_EQ(lines, (std::vector<std::string>{"one", "two", "three"}));
+    EXPECT_FALSE(process.getRight()->running());
+}
+
+/*
+    Spawning a command which writes way more than the capture limit
+    Expectation: only the last bytes are kept, long lines are cut at the limit
+*/
+TEST(SystemCommand, spawnBoundedOutput)
+{
+    std::vector<std::string> lines;
+    auto process = SystemCommand("head -c 1000000 /dev/zero | tr '\\0' 'a'; echo; echo last")
+                       .spawn(SystemCommand::Capture{.limit = 1024,
+                                                     .onLine = [&lines](auto line) { lines.emplace_back(line); }});
+    ASSERT_TRUE(process.isRight());
+
+    auto result = process.getRight()->wait();
+    ASSERT_EQ(result.output.size(), 1024);
+    EXPECT_TRUE(result.output.ends_with("aaa\nlast\n"));
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_EQ(lines[0], std::string(1024, 'a'));
+    EXPECT_EQ(lines[1], "last");
+}
+
+/*
+    Spawning a command with a log file
+    Expectation: the whole output ends up in the log file
+*/
+TEST(SystemCommand, spawnLogFile)
+{
+    const auto logFile = std::filesystem::temp_directory_path() / "enea_systemcommand_test.log";
+    {
+        auto process =
+            SystemCommand("echo first; echo second").spawn(SystemCommand::Capture{.limit = 4, .logFile = logFile});
+        ASSERT_TRUE(process.isRight());
+        EXPECT_EQ(process.getRight()->wait().output, "ond\n");
+    }
+
+    std::ifstream file(logFile);
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ(content.str(), "first\nsecond\n");
+    std::filesystem::remove(logFile);
+}
+
+/*
+    Polling a command which takes a long time
+    Expectation: polling does not block and reports the command is still running
+*/
+TEST(SystemCommand, spawnPoll)
+{
+    auto process = SystemCommand("sleep 10").spawn();
+    ASSERT_TRUE(process.isRight());
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(process.getRight()->poll().has_value());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    EXPECT_TRUE(process.getRight()->running());
+}
+
+/*
+    Cancelling a running command
+    Expectation: the command terminates gracefully well before it would have finished on its own
+*/
+TEST(SystemCommand, spawnCancel)
+{
+    auto process = SystemCommand("sleep 10").spawn();
+    ASSERT_TRUE(process.isRight());
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(process.getRight()->cancel());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    EXPECT_FALSE(process.getRight()->running());
+}
+
+/*
+    Cancelling a command which ignores the termination request
+    Expectation: the command is killed once the timeout expires
+*/
+TEST(SystemCommand, spawnCancelTimeout)
+{
+    auto process = SystemCommand("trap '' TERM; sleep 10").spawn();
+    ASSERT_TRUE(process.isRight());
+
+    // Giving the shell some time to install its trap
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_FALSE(process.getRight()->cancel(std::chrono::milliseconds(100)));
+    EXPECT_FALSE(process.getRight()->running());
+}
+
+/*
+    Dropping a command which ignores the termination request
+    Expectation: destruction returns right away and the command is killed in background once the timeout expires
+*/
+TEST(SystemCommand, spawnDestroyRunning)
+{
+    auto spawned = SystemCommand("trap '' TERM; sleep 10").spawn();
+    ASSERT_TRUE(spawned.isRight());
+    auto process = spawned.getRight();
+    spawned = decltype(spawned)::Left(SystemCommand::Error::LAUNCH_COMMAND);
+    const auto pid = process->pid();
+
+    // Giving the shell some time to install its trap
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    auto start = std::chrono::steady_clock::now();
+    process.reset();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, SystemCommand::Process::DEFAULT_CANCEL_TIMEOUT / 2);
+
+    const auto deadline = std::chrono::steady_clock::now() + SystemCommand::Process::DEFAULT_CANCEL_TIMEOUT * 3;
+    while (kill(pid, 0) == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    EXPECT_NE(kill(pid, 0), 0);
+}
+
+/*
+    Spawning a command given as an argument vector
+    Expectation: arguments reach the command untouched, spaces and quotes included, no shell is involved
+*/
+TEST(SystemCommand, spawnArguments)
+{
+    const std::vector<std::string> arguments{"printf", "%s|", "a path/with spaces", "\"quoted\"", "$HOME"};
+    auto process = SystemCommand(arguments).spawn();
+    ASSERT_TRUE(process.isRight());
+
+    auto result = process.getRight()->wait();
+    EXPECT_EQ(result.exitCode, 0);
+    EXPECT_EQ(result.output, "a path/with spaces|\"quoted\"|$HOME|");
+}
+
+/*
+    Spawning a command with an explicit environment
+    Expectation: the command sees exactly the given variables
+*/
+TEST(SystemCommand, spawnEnvironment)
+{
+    auto environment = SystemCommand::environment();
+    environment["ENEA_TEST"] = "enea";
+    auto process = SystemCommand(std::vector<std::string>{"env"}, environment).spawn();
+    ASSERT_TRUE(process.isRight());
+    EXPECT_NE(process.getRight()->wait().output.find("ENEA_TEST=enea\n"), std::string::npos);
+
+    process =
+        SystemCommand(std::vector<std::string>{"env"}, SystemCommand::Environment{{"ENEA_TEST", "enea"}}).spawn();
+    ASSERT_TRUE(process.isRight());
+    EXPECT_EQ(process.getRight()->wait().output, "ENEA_TEST=enea\n");
+}
+
+/*
+    Spawning a command which does not exist
+    Expectation: an error is returned
+*/
+TEST(SystemCommand, spawnNonExistant)
+{
+    auto process = SystemCommand(std::vector<std::string>{"enea_command_which_does_not_exist"}).spawn();
+    ASSERT_TRUE(process.isLeft());
+    EXPECT_EQ(process.getLeft(), SystemCommand::Error::LAUNCH_COMMAND);
+}
+#endif
@@ -0,0 +1,129 @@
+#include "textbatch.hpp"
+
+#include <cstdlib>
+
+#include <SFML/Graphics/Text.hpp>
+#include <gtest/gtest.h>
+
+#include "internalresourcemanager.hpp"
+
+static constexpr unsigned int CHARACTER_SIZE = 32;
+static constexpr float LINE_HEIGHT = 48.0F;
+// Glyph quads are padded by one pixel on every side, as sf::Text does
+static constexpr float PADDING = 1.0F;
+
+// Both sides add up the same numbers, though not always in the same order
+static void expectBoundsEq(const sf::FloatRect& bounds, const sf::FloatRect& expected)
+{
+    EXPECT_FLOAT_EQ(bounds.left, expected.left);
+    EXPECT_FLOAT_EQ(bounds.top, expected.top);
+    EXPECT_FLOAT_EQ(bounds.width, expected.width);
+    EXPECT_FLOAT_EQ(bounds.height, expected.height);
+}
+
+class TextBatchFixture : public ::testing::Test
+{
+ protected:
+    const sf::Font* font = nullptr;
+
+    void SetUp() override
+    {
+#ifdef TARGET_OS_LINUX
+        // Glyphs are rendered into a texture, which takes an OpenGL context and so a display. ctest runs these tests
+        // under xvfb-run when it is installed
+        if (std::getenv("DISPLAY") == nullptr)
+        {
+            GTEST_SKIP() << "No display available, install xvfb-run to run these tests headless";
+        }
+#endif
+        font = &FontManager::get().getResource("fonts/inter.ttf");
+    }
+};
+
+/*
+    Laying out lines with kerning, spaces and tabs.
+    Expectation: every glyph is where sf::Text puts it and every line has the bounds sf::Text has.
+*/
+TEST_F(TextBatchFixture, layout)
+{
+    const std::vector<sf::String> lines{"Metal Slug 3", "The King of Fighters '98", "AVA\tWAVE To", " Trailing "};
+    TextBatch batch(*font, CHARACTER_SIZE, LINE_HEIGHT);
+    for (const auto& line : lines)
+    {
+        batch.addLine(line, sf::Color::Red);
+    }
+    ASSERT_EQ(batch.lines(), lines.size());
+
+    std::size_t vertex = 0;
+    for (std::size_t i = 0; i < lines.size(); i++)
+    {
+        const sf::Text text(lines[i], *font, CHARACTER_SIZE);
+        const float offset = static_cast<float>(i) * LINE_HEIGHT;
+
+        auto expected = text.getLocalBounds();
+        expected.top += offset;
+        expectBoundsEq(batch.bounds(i), expected);
+
+        // findCharacterPos leaves out the kerning with the previous character, quads include it
+        sf::Uint32 previous = 0;
+        for (std::size_t character = 0; character < lines[i].getSize(); character++)
+        {
+            const sf::Uint32 current = lines[i][character];
+            const float kerning = font->getKerning(previous, current, CHARACTER_SIZE);
+            previous = current;
+            if (current == U' ' || current == U'\t')
+            {
+                continue;
+            }
+
+            const auto& glyph = font->getGlyph(current, CHARACTER_SIZE, false);
+            const auto position = text.findCharacterPos(character);
+            const auto& topLeft = batch.vertices()[vertex].position;
+            EXPECT_FLOAT_EQ(topLeft.x, position.x + kerning + glyph.bounds.left - PADDING) << "Line " << i;
+            EXPECT_FLOAT_EQ(topLeft.y, offset + CHARACTER_SIZE + glyph.bounds.top - PADDING) << "Line " << i;
+            vertex += 6;
+        }
+    }
+    EXPECT_EQ(batch.vertices().getVertexCount(), vertex);
+}
+
+/*
+    Recoloring a line.
+    Expectation: only the vertices of that line change color.
+*/
+TEST_F(TextBatchFixture, setColor)
+{
+    TextBatch batch(*font, CHARACTER_SIZE, LINE_HEIGHT);
+    batch.addLine("Aof", sf::Color::Red);
+    batch.addLine("Kof", sf::Color::Red);
+    batch.setColor(1, sf::Color::White);
+    // Out of range lines are ignored
+    batch.setColor(2, sf::Color::White);
+
+    const auto& vertices = batch.vertices();
+    ASSERT_EQ(vertices.getVertexCount(), 36);
+    for (std::size_t i = 0; i < vertices.getVertexCount(); i++)
+    {
+        EXPECT_EQ(vertices[i].color, i < 18 ? sf::Color::Red : sf::Color::White) << "Vertex " << i;
+    }
+}
+
+/*
+    Clearing a batch and adding lines again.
+    Expectation: new lines start from the top again.
+*/
+TEST_F(TextBatchFixture, clear)
+{
+    TextBatch batch(*font, CHARACTER_SIZE, LINE_HEIGHT);
+    batch.addLine("Aof", sf::Color::Red);
+    batch.addLine("Kof", sf::Color::Red);
+    const auto firstLine = batch.bounds(0);
+
+    batch.clear();
+    EXPECT_EQ(batch.lines(), 0);
+    EXPECT_EQ(batch.vertices().getVertexCount(), 0);
+
+    batch.addLine("Aof", sf::Color::Red);
+    EXPECT_EQ(batch.lines(), 1);
+    expectBoundsEq(batch.bounds(0), firstLine);
+}
@@ -0,0 +1,74 @@
+#include "utils/ringbuffer.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+/**
+ * Write less than the capacity of a ring buffer.
+ *
+ * Expectations:
+ *  - Everything is stored
+ *  - Nothing is dropped
+ */
+TEST(RingBuffer, appendWithinCapacity)
+{
+    RingBuffer buffer(8);
+    buffer.append("abc");
+    buffer.append("de");
+
+    EXPECT_EQ(buffer.str(), "abcde");
+    EXPECT_EQ(buffer.size(), 5);
+    EXPECT_EQ(buffer.dropped(), 0);
+}
+
+/**
+ * Write more than the capacity of a ring buffer, a little at a time.
+ *
+ * Expectations:
+ *  - Only the last bytes are kept, oldest first
+ *  - The overwritten bytes are counted
+ */
+TEST(RingBuffer, appendWrapsAround)
+{
+    RingBuffer buffer(4);
+    buffer.append("abc");
+    buffer.append("def");
+    EXPECT_EQ(buffer.str(), "cdef");
+
+    buffer.append("g");
+    EXPECT_EQ(buffer.str(), "defg");
+    EXPECT_EQ(buffer.size(), 4);
+    EXPECT_EQ(buffer.dropped(), 3);
+}
+
+/**
+ * Write more than the capacity of a ring buffer at once.
+ *
+ * Expectations:
+ *  - Only the tail of what was written is kept
+ */
+TEST(RingBuffer, appendBiggerThanCapacity)
+{
+    RingBuffer buffer(4);
+    buffer.append("ab");
+    buffer.append("0123456789");
+
+    EXPECT_EQ(buffer.str(), "6789");
+    EXPECT_EQ(buffer.dropped(), 8);
+}
+
+/**
+ * Write a lot to a ring buffer with no capacity.
+ *
+ * Expectations:
+ *  - Nothing is stored, everything is dropped
+ */
+TEST(RingBuffer, zeroCapacity)
+{
+    RingBuffer buffer(0);
+    buffer.append("abc");
+
+    EXPECT_EQ(buffer.str(), "");
+    EXPECT_EQ(buffer.dropped(), 3);
+}
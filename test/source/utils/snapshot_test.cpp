@@ -0,0 +1,107 @@
+#include "utils/snapshot.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+/**
+ * Read a snapshot nothing was published to.
+ *
+ * Expectations:
+ *  - The reader holds no value
+ *  - Refreshing does not grab anything
+ */
+TEST(Snapshot, readEmpty)
+{
+    Snapshot<int> snapshot;
+    Snapshot<int>::Reader reader(snapshot);
+
+    EXPECT_EQ(reader.get(), nullptr);
+    EXPECT_FALSE(reader.refresh());
+    EXPECT_EQ(snapshot.version(), 0);
+}
+
+/**
+ * Publish a value and then a newer one.
+ *
+ * Expectations:
+ *  - The reader keeps the old value until it refreshes
+ *  - The old value is still alive while the reader holds it and is freed once it refreshes
+ */
+TEST(Snapshot, publish)
+{
+    Snapshot<int> snapshot;
+    snapshot.publish(std::make_shared<const int>(1));
+
+    Snapshot<int>::Reader reader(snapshot);
+    ASSERT_NE(reader.get(), nullptr);
+    EXPECT_EQ(*reader.get(), 1);
+    EXPECT_FALSE(reader.refresh());
+
+    std::weak_ptr<const int> old = reader.get();
+    snapshot.publish(std::make_shared<const int>(2));
+    EXPECT_EQ(*reader.get(), 1);
+    EXPECT_FALSE(old.expired());
+
+    EXPECT_TRUE(reader.refresh());
+    EXPECT_EQ(*reader.get(), 2);
+    EXPECT_TRUE(old.expired());
+    EXPECT_EQ(*snapshot.load(), 2);
+}
+
+/**
+ * Publish many versions while other threads keep reading.
+ *
+ * Expectations:
+ *  - Readers always see a complete version and versions never go backwards
+ */
+TEST(Snapshot, concurrentReaders)
+{
+    static constexpr int VERSIONS = 1000;
+    static constexpr int READERS = 4;
+
+    Snapshot<std::vector<int>> snapshot;
+    std::atomic<bool> done = false;
+    std::atomic<int> failures = 0;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < READERS; i++)
+    {
+        readers.emplace_back([&snapshot, &done, &failures]() {
+            Snapshot<std::vector<int>>::Reader reader(snapshot);
+            int last = 0;
+            while (!done)
+            {
+                std::ignore = reader.refresh();
+                if (const auto& current = reader.get(); current)
+                {
+                    // Every version is filled with its own number, a mix would mean a torn read
+                    if (current->size() != static_cast<std::size_t>(current->front()) ||
+                        std::ranges::count(*current, current->front()) != current->front() || current->front() < last)
+                    {
+                        failures++;
+                    }
+
+                    last = current->front();
+                }
+            }
+        });
+    }
+
+    for (int i = 1; i <= VERSIONS; i++)
+    {
+        snapshot.publish(std::make_shared<const std::vector<int>>(i, i));
+    }
+
+    done = true;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(failures, 0);
+    EXPECT_EQ(snapshot.version(), VERSIONS);
+}